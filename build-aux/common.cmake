@@ -144,6 +144,11 @@ if(USE_WERROR)
     ADD_C_FLAG("W_ERROR" "-Werror")
 endif()
 
+option(ENABLE_DEBUG_MSGS "Set to OFF to compile out debug messages and plots" ON)
+if(NOT ENABLE_DEBUG_MSGS)
+    add_definitions("-DCL_DEBUG_MSGS=0")
+endif()
+
 # mallinfo2 support
 CHECK_C_SYMBOL_AVAILABLE(mallinfo2 "malloc.h")
 
@@ -22,9 +22,9 @@
 
 #include <cl/cl_msg.hh>
 #include <cl/clutil.hh>
+#include <cl/stopwatch.hh>
 #include <cl/storage.hh>
 
-#include "stopwatch.hh"
 #include "worklist.hh"
 
 namespace CodeStorage {
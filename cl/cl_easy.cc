@@ -24,13 +24,13 @@
 #include <cl/easy.hh>
 #include <cl/killer.hh>
 #include <cl/memdebug.hh>
+#include <cl/stopwatch.hh>
 #include <cl/storage.hh>
 
 #include "callgraph.hh"
 #include "cl_storage.hh"
 #include "loopscan.hh"
 #include "pointsto.hh"
-#include "stopwatch.hh"
 
 #include <string>
 
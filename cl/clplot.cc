@@ -229,18 +229,21 @@ void ptPlotSubGraph(PlotCtx &ctx)
 
     WorkList<Node *> wl;
     for (const TMap::value_type &t : ptg.map) {
-        wl.schedule(t.second);
+        wl.schedule(repOf(t.second));
     }
 
+    // edges may refer to nodes that have been joined meanwhile, plot their
+    // representatives instead (see PointsTo::repOf())
     Node *plotNode;
     while (wl.next(plotNode)) {
         dotPlotNode(ctx, plotNode);
         for (Node *outNode : plotNode->outNodes) {
+            outNode = repOf(outNode);
             dotPlotEdge(ctx, plotNode, outNode);
             wl.schedule(outNode);
         }
         for (Node *inNode : plotNode->inNodes) {
-            wl.schedule(inNode);
+            wl.schedule(repOf(inNode));
         }
     }
 }
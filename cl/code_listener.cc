@@ -29,6 +29,10 @@
 #include <cstdio>
 #include <cstdlib>
 #include <cstring>
+#include <fstream>
+#include <map>
+#include <string>
+#include <vector>
 
 #include <unistd.h>
 
@@ -91,6 +95,217 @@ static struct cl_init_data init_data = {
     0                      // .debug_level
 };
 
+/// a warning/error message together with the notes following it
+struct MsgDiag {
+    bool                                isError;
+    std::string                         head;
+    std::vector<std::string>            notes;
+    size_t                              btHash;
+    unsigned                            cnt;
+};
+
+/// see cl_msg_collect_start() and cl_msg_collect_flush() for details
+struct MsgCollector {
+    typedef std::pair<size_t /* idx */, size_t /* bt hash */>   TKeyTail;
+    typedef std::map<std::string /* head */, std::vector<TKeyTail> > TIndex;
+
+    bool                                enabled;
+    int                                 maxTraces;
+    int                                 cntTraces;
+    std::vector<MsgDiag>                diags;
+    TIndex                              index;
+    MsgDiag                             open;
+    bool                                hasOpen;
+
+    MsgCollector():
+        enabled(false),
+        maxTraces(-1),
+        cntTraces(0),
+        hasOpen(false)
+    {
+    }
+
+    void receive(bool isError, const char *msg);
+    void commit();
+    void emit(const MsgDiag &diag);
+};
+
+static MsgCollector msg_col;
+
+void MsgCollector::receive(bool isError, const char *msg)
+{
+    // a warning/error starts a new diagnostic, the previous one is complete
+    this->commit();
+
+    open.isError = isError;
+    open.head = msg;
+    open.notes.clear();
+    hasOpen = true;
+}
+
+void MsgCollector::commit()
+{
+    if (!hasOpen)
+        return;
+
+    hasOpen = false;
+
+    // the notes carry the backtrace (or even the full trace) of the defect,
+    // notes with internal location (such as names of dumped files) do not
+    static const std::string internal = " [internal location]";
+    std::string bt;
+    for (const std::string &note : open.notes) {
+        if (internal.size() <= note.size() && !note.compare(
+                    note.size() - internal.size(), internal.size(), internal))
+            continue;
+
+        bt += note + "\n";
+    }
+
+    open.btHash = std::hash<std::string>()(bt);
+    open.cnt = 1U;
+
+    // look for the same diagnostic reached already
+    std::vector<TKeyTail> &tails = index[open.head];
+    for (const TKeyTail &tail : tails) {
+        if (tail.second != open.btHash)
+            continue;
+
+        MsgDiag &diag = diags[tail.first];
+        if (diag.isError != open.isError)
+            continue;
+
+        ++diag.cnt;
+        return;
+    }
+
+    // a new diagnostic, emit it right away so that it is not lost if the
+    // analysis does not finish
+    tails.push_back(TKeyTail(diags.size(), open.btHash));
+    diags.push_back(open);
+    this->emit(open);
+}
+
+void MsgCollector::emit(const MsgDiag &diag)
+{
+    if (diag.isError)
+        init_data.error(diag.head.c_str());
+    else
+        init_data.warn(diag.head.c_str());
+
+    // emit its trace unless the limit has been reached
+    const bool printTrace = (maxTraces < 0) || (cntTraces < maxTraces);
+    if (!printTrace || diag.notes.empty())
+        return;
+
+    ++cntTraces;
+    for (const std::string &note : diag.notes)
+        init_data.note(note.c_str());
+}
+
+static void msg_split_head(
+        std::string                     *pLoc,
+        std::string                     *pText,
+        const MsgDiag                   &diag)
+{
+    const std::string &head = diag.head;
+    const char *marker = (diag.isError) ? ": error: " : ": warning: ";
+    const size_t pos = head.find(marker);
+    if (std::string::npos == pos) {
+        pLoc->clear();
+        *pText = head;
+        return;
+    }
+
+    *pLoc = head.substr(0, pos);
+    *pText = head.substr(pos + strlen(marker));
+}
+
+static void msg_json_str(std::ostream &str, const std::string &text)
+{
+    str << "\"";
+    for (const char c : text) {
+        switch (c) {
+            case '"':   str << "\\\"";  break;
+            case '\\':  str << "\\\\";  break;
+            case '\n':  str << "\\n";    break;
+            case '\t':  str << "\\t";    break;
+
+            default:
+                if (static_cast<unsigned char>(c) < 0x20) {
+                    char buf[sizeof "\\u0000"];
+                    sprintf(buf, "\\u%04x", c);
+                    str << buf;
+                }
+                else
+                    str << c;
+        }
+    }
+    str << "\"";
+}
+
+void cl_msg_collect_start(int max_traces)
+{
+    msg_col.enabled = true;
+    msg_col.maxTraces = max_traces;
+    msg_col.cntTraces = 0;
+}
+
+void cl_msg_collect_flush(const char *report_file)
+{
+    if (!msg_col.enabled)
+        return;
+
+    msg_col.commit();
+    msg_col.enabled = false;
+
+    std::ofstream report;
+    if (report_file) {
+        report.open(report_file);
+        if (!report)
+            CL_WARN("unable to write diagnostics report: " << report_file);
+    }
+
+    for (const MsgDiag &diag : msg_col.diags) {
+        std::string loc, text;
+        msg_split_head(&loc, &text, diag);
+
+        // the diagnostic itself has been emitted already, now report its count
+        if (1U < diag.cnt) {
+            std::ostringstream str;
+            if (!loc.empty())
+                str << loc << ": ";
+
+            str << "note: " << ((diag.isError) ? "error" : "warning")
+                << " \"" << text << "\" has been reached " << diag.cnt
+                << " times";
+            init_data.note(str.str().c_str());
+        }
+
+        if (!report)
+            continue;
+
+        // one JSON object per line
+        char hash[sizeof(size_t) * 2 + 1];
+        sprintf(hash, "%0*zx", static_cast<int>(sizeof(size_t) * 2),
+                diag.btHash);
+
+        report << "{\"kind\": "
+            << ((diag.isError) ? "\"error\"" : "\"warning\"")
+            << ", \"loc\": ";
+        msg_json_str(report, loc);
+        report << ", \"msg\": ";
+        msg_json_str(report, text);
+        report << ", \"bt_hash\": \"" << hash << "\""
+            << ", \"count\": " << diag.cnt
+            << ", \"notes\": " << diag.notes.size()
+            << "}\n";
+    }
+
+    msg_col.diags.clear();
+    msg_col.index.clear();
+}
+
 void cl_debug(const char *msg)
 {
     init_data.debug(msg);
@@ -98,24 +313,42 @@ void cl_debug(const char *msg)
 
 void cl_warn(const char *msg)
 {
+    if (msg_col.enabled) {
+        msg_col.receive(/* isError */ false, msg);
+        return;
+    }
+
     CHK_LAST(msg, /* filter */ true);
     init_data.warn(msg);
 }
 
 void cl_error(const char *msg)
 {
+    if (msg_col.enabled) {
+        msg_col.receive(/* isError */ true, msg);
+        return;
+    }
+
     CHK_LAST(msg, /* filter */ true);
     init_data.error(msg);
 }
 
 void cl_note(const char *msg)
 {
+    if (msg_col.enabled && msg_col.hasOpen) {
+        msg_col.open.notes.push_back(msg);
+        return;
+    }
+
     CHK_LAST(msg, /* filter */ false);
     init_data.note(msg);
 }
 
 void cl_die(const char *msg)
 {
+    // do not lose the last collected diagnostic (and its notes)
+    msg_col.commit();
+
     // this call should never return (TODO: annotation?)
     init_data.die(msg);
     abort();
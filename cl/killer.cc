@@ -23,11 +23,11 @@
 #include <cl/cl_msg.hh>
 #include <cl/cldebug.hh>
 #include <cl/clutil.hh>
+#include <cl/stopwatch.hh>
 #include <cl/storage.hh>
 
 #include "pointsto.hh"
 #include "builtins.hh"
-#include "stopwatch.hh"
 #include "util.hh"
 
 #include <map>
@@ -21,10 +21,10 @@
 #include "loopscan.hh"
 
 #include <cl/cl_msg.hh>
+#include <cl/stopwatch.hh>
 #include <cl/storage.hh>
 
 #include "util.hh"
-#include "stopwatch.hh"
 
 #include <set>
 #include <stack>
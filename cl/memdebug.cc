@@ -146,6 +146,17 @@ bool printPeakMemUsage()
     return true;
 }
 
+bool peakMemUsage(ssize_t *pDst)
+{
+#ifndef HAVE_MALLINFO2
+    if (::overflowDetected)
+        return false;
+#endif
+
+    *pDst = ::peak - ::memDrift;
+    return true;
+}
+
 #else // DEBUG_MEM_USAGE
 
 bool rawMemUsage(ssize_t *)
@@ -173,4 +184,9 @@ bool printPeakMemUsage()
     return false;
 }
 
+bool peakMemUsage(ssize_t *)
+{
+    return false;
+}
+
 #endif
@@ -20,7 +20,6 @@
 #include "config_cl.h"
 
 #include "util.hh"
-#include "stopwatch.hh"
 #include "builtins.hh"
 
 #include "pointsto.hh"
@@ -31,6 +30,7 @@
 #include "clplot.hh"
 
 #include <cl/clutil.hh>
+#include <cl/stopwatch.hh>
 
 #include <algorithm>
 
@@ -40,22 +40,62 @@ namespace CodeStorage {
 
 namespace PointsTo {
 
+Node *repOf(Node *node)
+{
+    Node *root = node;
+    while (root->joinedTo)
+        root = root->joinedTo;
+
+    // path compression
+    while (node != root) {
+        Node *next = node->joinedTo;
+        node->joinedTo = root;
+        node = next;
+    }
+
+    return root;
+}
+
+const Node *repOf(const Node *node)
+{
+    return repOf(const_cast<Node *>(node));
+}
+
 // there may occur multiple out-edges
 void addEdge(Node *from, Node *to)
 {
-    insertOnce(from->outNodes, to);
-    insertOnce(to->inNodes, from);
+    from = repOf(from);
+    to = repOf(to);
+
+    for (Node *&out : from->outNodes) {
+        out = repOf(out);
+        if (out == to)
+            // the edge already exists
+            return;
+    }
+
+    // the in-edges are recorded once per out-edge, but they may duplicate
+    // each other once their source nodes get joined (see joinNodesS())
+    from->outNodes.push_back(to);
+    to->inNodes.push_back(from);
 }
 
 void clearEdgeS(Node *from, Node *to)
 {
-    CL_BREAK_IF(!hasKey(from->outNodes, to));
-    CL_BREAK_IF(!hasKey(to->inNodes, from));
+    CL_BREAK_IF(from != repOf(from) || to != repOf(to));
+    CL_BREAK_IF(from->outNodes.size() != 1);
+    from->outNodes.clear();
+
+    // drop all in-edges of 'to' that lead from 'from' (or from its links)
+    TNodeList &inNodes = to->inNodes;
+    unsigned dst = 0;
+    for (unsigned src = 0; src < inNodes.size(); ++src) {
+        if (repOf(inNodes[src]) != from)
+            inNodes[dst++] = inNodes[src];
+    }
 
-    from->outNodes.erase(to);
-    to->inNodes.erase(from);
-    // no out node may remain for Single-Output graph
-    CL_BREAK_IF(from->outNodes.size() != 0);
+    CL_BREAK_IF(dst == inNodes.size());
+    inNodes.resize(dst);
 }
 
 bool bindVarList(
@@ -75,6 +115,8 @@ bool bindVarList(
             continue;
         }
 
+        // 'target' could have been joined into another node in the meanwhile
+        target = repOf(target);
         if (hasItem(target->variables, i))
             // this variable is in target node already
             continue;
@@ -110,6 +152,7 @@ Node *preventEndingS(Node *node)
 void bindItem(Graph &ptg, Node *n, const Item *i)
 {
     CL_BREAK_IF(!n || !i);
+    n = repOf(n);
 
     cl_uid_t uid = i->uid();
 
@@ -147,70 +190,49 @@ void joinFixPointS(BuildCtx &ctx, Graph &ptg)
 
 void joinNodesS(
         BuildCtx                       &ctx,
-        Graph                          &ptg,
+        Graph                          &,
         Node                           *nodeLeft,
         Node                           *nodeRight)
 {
     CL_BREAK_IF(existsError(ctx.stor));
 
+    nodeLeft = repOf(nodeLeft);
+    nodeRight = repOf(nodeRight);
     if (nodeLeft == nodeRight)
         // just skip -- do not fail
         return;
 
+    // harvest the (at most one) out-coming edge of nodeRight
+    Node *rightTarget = getOutputS(nodeRight);
+    if (rightTarget)
+        clearEdgeS(nodeRight, rightTarget);
+
+    // move nodeRight's variables to nodeLeft, the map entries pointing to
+    // nodeRight are resolved by repOf() on the next lookup
+    TItemList &vars = nodeLeft->variables;
     for (const Item *i : nodeRight->variables)
-        // re-map nodeB's variables to nodeA
-        bindItem(ptg, nodeLeft, i);
-
-    // harvest all existing rightNode-related edges
-    Node *leftTarget, *rightTarget;
-    std::vector<TNodePair> pairs;
-    TNodeList &inNodes = nodeRight->inNodes;
-    while (inNodes.size() != 0) {
-        Node *inNodeRight = *inNodes.begin();
-        pairs.push_back(TNodePair(inNodeRight, nodeRight));
-        clearEdgeS(inNodeRight, nodeRight);
-    }
-    CL_BREAK_IF(inNodes.size() > 0);
+        if (!hasItem(vars, i))
+            vars.push_back(i);
+    TItemList().swap(nodeRight->variables);
 
-    rightTarget = getOutputS(nodeRight);
-    if (rightTarget) {
-        pairs.push_back(TNodePair(nodeRight, rightTarget));
-        clearEdgeS(nodeRight, rightTarget);
-    }
-    CL_BREAK_IF(nodeRight->outNodes.size() > 0);
+    // in-coming edges of nodeRight now lead to nodeLeft
+    TNodeList &inNodes = nodeLeft->inNodes;
+    inNodes.insert(inNodes.end(),
+            nodeRight->inNodes.begin(),
+            nodeRight->inNodes.end());
+    TNodeList().swap(nodeRight->inNodes);
 
-    // FIXME: this causes a USE_AFTER_FREE in bindVarList() on the line where
-    //        we check hasKey(target->variables, i) in case we are called from
-    //        there via joinFixPointS(), see tests/predator-regre/test-0701.c
-    //        (attach_buffer_insert_head_list.c from SLAyer) for a reproducer
-#if 0
-    delete nodeRight;
-#endif
+    // this makes nodeLeft the representative of nodeRight
+    nodeRight->joinedTo = nodeLeft;
 
     // the graph should be OK again
     CL_BREAK_IF(existsError(ctx.stor));
 
-    rightTarget = NULL;
-    for (TNodePair &p : pairs) {
-        if (p.first != nodeRight) {
-            // handle in-coming to nodeRight
-            CL_BREAK_IF(p.second != nodeRight);
-            // simply add reference from p->first to nodeLeft even if it would
-            // be a nodeLeft itself.
-            addEdge(p.first, nodeLeft);
-            continue;
-        }
-
-        // handle out-coming (at most one out-coming edge
-        CL_BREAK_IF(rightTarget);
-        rightTarget = p.second;
-    }
-
     if (!rightTarget)
         // we are done for now..
         return;
 
-    leftTarget = getOutputS(nodeLeft);
+    Node *leftTarget = getOutputS(nodeLeft);
 
     if (rightTarget == nodeRight) {
         // there was self loop before
@@ -243,7 +265,7 @@ const Node *existsUid(const Graph &graph, cl_uid_t uid)
     if (it == map.end())
         return NULL;
 
-    return it->second;
+    return repOf(it->second);
 }
 
 const Node *existsVar(const Graph &graph, const Var *v)
@@ -258,24 +280,24 @@ const Node *existsItem(const Graph &graph, const Item *i)
 
 Node *findNode(Graph &ptg, cl_uid_t uid)
 {
-    if (existsUid(ptg, uid))
-        return ptg.map[uid];
-    return 0;
+    TMap::iterator it = ptg.map.find(uid);
+    if (ptg.map.end() == it)
+        return NULL;
+
+    // update the map entry in case the node has been joined meanwhile
+    Node *&node = it->second;
+    node = repOf(node);
+    return node;
 }
 
 Node *findNode(Graph &ptg, const Var *v)
 {
-    if (existsVar(ptg, v))
-        return ptg.map[v->uid];
-    return 0;
+    return findNode(ptg, v->uid);
 }
 
 Node *findNode(Graph &ptg, const Item *i)
 {
-    cl_uid_t uid = i->uid();
-    if (existsUid(ptg, uid))
-        return ptg.map[uid];
-    return NULL;
+    return findNode(ptg, i->uid());
 }
 
 Node *allocNodeForItem(Graph &ptg, const Item *i)
@@ -321,10 +343,9 @@ Node *getNode(Graph &ptg, const Var *v)
 Node *getNode(Graph &ptg, const Item *i)
 {
     CL_BREAK_IF(!i);
-    cl_uid_t uid = i->uid();
     CL_BREAK_IF(!hasKey(ptg.map, i->uid()));
 
-    return ptg.map[uid];
+    return findNode(ptg, i->uid());
 }
 
 Node *nodeFromForeign(Graph &ptg, const Item *ref)
@@ -344,6 +365,7 @@ Node *nodeFromForeign(Graph &ptg, const Item *ref)
 
 void setBlackHole(Graph &ptg, Node *n)
 {
+    n = repOf(n);
     ptg.blackHole = n;
     n->isBlackHole = true;
 }
@@ -361,9 +383,17 @@ void appendNodeS(BuildCtx &ctx, Graph&, Node *parent, Node *what)
 
 Node *getOutputS(Node *node)
 {
-    int outCnt = node->outNodes.size();
+    node = repOf(node);
+    TNodeList &outNodes = node->outNodes;
+    int outCnt = outNodes.size();
     assert(outCnt <= 1);
-    return outCnt ? *node->outNodes.begin() : NULL;
+    if (!outCnt)
+        return NULL;
+
+    // update the edge in case its target has been joined meanwhile
+    Node *&target = outNodes.front();
+    target = repOf(target);
+    return target;
 }
 
 const Node *hasOutputS(const Node *node)
@@ -373,6 +403,7 @@ const Node *hasOutputS(const Node *node)
 
 Node *appendEmptyS(Node *source)
 {
+    source = repOf(source);
     CL_BREAK_IF(source->outNodes.size() > 0);
     Node *target = new Node;
     addEdge(source, target);
@@ -394,17 +425,10 @@ Node *nodeAccessS(
     // node in Graph
     struct cl_accessor * ac = op.accessor;
     for (; ac; ac = ac->next) {
-        size_t size;
-
         switch (ac->code) {
             case CL_ACCESSOR_DEREF:
-                size = root->outNodes.size();
-                CL_BREAK_IF(size > 1);
-                if (size != 0)
-                    // there is output edge already
-                    root = *root->outNodes.begin();
-                else
-                    root = appendEmptyS(root);
+                // use the output edge if there is one already
+                root = preventEndingS(root);
                 break;
             case CL_ACCESSOR_ITEM:
             case CL_ACCESSOR_OFFSET:
@@ -451,6 +475,7 @@ bool follows(const Node *a, const Node *b)
     const Node *processed;
     while (wl.next(processed)) {
         for (const Node *next : processed->outNodes) {
+            next = repOf(next);
             if (next == b)
                 return true;
             wl.schedule(next);
@@ -490,10 +515,10 @@ bool isPointed(const Graph &ptg, const Var *v)
         return false;
 
     for (const Node *pointer : target->inNodes) {
-        if (pointer == target) {
+        if (repOf(pointer) == target) {
             // self loop on this node -- is there any other variable in this
             // node?
-            for (const Item *other : pointer->variables) {
+            for (const Item *other : repOf(pointer)->variables) {
                 switch (other->code) {
                     case PT_ITEM_RET:
                         return true;
@@ -528,11 +553,7 @@ Node *goDownS(Node *start, int steps)
 {
     Node *node = start;
     while (steps > 0) {
-        if (!hasOutputS(node))
-            appendEmptyS(node);
-
-        CL_BREAK_IF(node->outNodes.size() != 1);
-        node = getOutputS(node);
+        node = preventEndingS(node);
         steps--;
     }
 
@@ -571,21 +592,20 @@ void chkOutNodes(const Graph &, const Node *n)
     if (size == 0)
         return;
 
-    const Node *outNode = *outNodes.begin();
+    const Node *outNode = repOf(outNodes.front());
     CL_BREAK_IF(!outNode);
 
+    // the in-edges may be duplicated after joining of their source nodes
     bool found = false;
     for (const Node *inNode : outNode->inNodes) {
-        if (inNode != n)
-            continue;
-
-        if (found)
-            CL_BREAK_IF("double in-node");
-
-        found = true;
+        if (repOf(inNode) == n) {
+            found = true;
+            break;
+        }
     }
 
     CL_BREAK_IF(!found);
+    (void) found;
 }
 
 void chkInNodes(const Graph &, const Node *n)
@@ -617,7 +637,7 @@ void chkGraphS(const Graph &g)
 {
     WorkList<const Node *> wl;
     for (TMap::const_reference pair : g.map) {
-        wl.schedule(pair.second);
+        wl.schedule(repOf(pair.second));
     }
 
     const Node *handled;
@@ -87,8 +87,10 @@ namespace PointsTo {
      * Join two nodes: nodeA = nodeA JOIN nodeB
      *
      * This must always KEEP nodeA on the same place as-is (it may be referenced
-     * by others) but nodeB is going to be deleted completely (there must be
-     * guaranteed that nobody is pointing it before this operation).
+     * by others).  The nodes are merged in the union-find manner -- nodeB is
+     * not deleted but it is linked to nodeA, which becomes its representative.
+     * Edges and map entries that still refer to nodeB are resolved lazily by
+     * repOf(), so nobody needs to be re-targeted here.
      */
     void joinNodesS(
             BuildCtx                   &ctx,
@@ -96,6 +98,14 @@ namespace PointsTo {
             Node                       *nodeA,
             Node                       *nodeB);
 
+    /**
+     * Return the representative of the given node, i.e. the node itself unless
+     * it has been joined into another node by joinNodesS().  The links on the
+     * way are shortened (path compression), so that lookups stay cheap.
+     */
+    Node *repOf(Node *node);
+    const Node *repOf(const Node *node);
+
     /**
      * Start the merging of nodes based on ctx.joinTodo information.  This
      * function uses joinNodesS() internally.
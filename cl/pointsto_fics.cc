@@ -451,12 +451,9 @@ RetVal phase1handleInsn(
         // address taken -- just append this operand as a following node
         appendNodeS(ctx, ptg, left, right);
     else {
-        preventEndingS(left);
-        preventEndingS(right);
-
         ctx.joinTodo.push_back(std::make_pair(
-                *left->outNodes.begin(),
-                *right->outNodes.begin()));
+                preventEndingS(left),
+                preventEndingS(right)));
     }
 
     // go down through accessors to find following join-candidates
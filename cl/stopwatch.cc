@@ -17,7 +17,7 @@
  * along with predator.  If not, see <http://www.gnu.org/licenses/>.
  */
 
-#include "stopwatch.hh"
+#include <cl/stopwatch.hh>
 #include <iomanip>
 #include <time.h>
 
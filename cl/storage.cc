@@ -369,6 +369,12 @@ bool Block::isLoopEntry() const
     return false;
 }
 
+bool Block::isEbbInterior() const
+{
+    return (1U == inbound_.size())
+        && !this->isLoopEntry();
+}
+
 
 // /////////////////////////////////////////////////////////////////////////////
 // PointsTo implementation
@@ -453,6 +459,7 @@ const Var *Item::var() const
 }
 
 Node::Node():
+    joinedTo(0),
     isBlackHole(false)
 {
 }
@@ -43,6 +43,22 @@
     abort(); \
 } while (0)
 
+/**
+ * if 0, debug messages are compiled out completely, including evaluation of
+ * their arguments and the run-time check of cl_debug_level()
+ * @note This is usually set by the build system (ENABLE_DEBUG_MSGS=OFF).
+ */
+#ifndef CL_DEBUG_MSGS
+#   define CL_DEBUG_MSGS 1
+#endif
+
+/**
+ * true if debug messages are being emitted, useful to hoist the check out of
+ * loops.  It is a compile-time false if CL_DEBUG_MSGS is 0.
+ */
+#define CL_DEBUG_ENABLED() \
+    (CL_DEBUG_MSGS && cl_debug_level())
+
 /**
  * standard output stream wrapper on top of the code listener interface
  * @param fnc a function used to emit the message - cl_debug(), cl_warn(),
@@ -51,7 +67,7 @@
  * operator<<(std::ostream, ...) is a viable start.
  */
 #define CL_MSG_STREAM(fnc, to_stream) do {          \
-    if ((cl_debug == (fnc)) && !cl_debug_level())   \
+    if ((cl_debug == (fnc)) && !CL_DEBUG_ENABLED()) \
         break;                                      \
                                                     \
     std::ostringstream str;                         \
@@ -126,19 +142,19 @@
     CL_MSG_STREAM(cl_note, *(loc) << "note: " << what)
 
 /// same as CL_DEBUG, but compares the current debug level with the given one
-#define CL_DEBUG_AT(level, what) do {               \
-    if (cl_debug_level() < (level))                 \
-        break;                                      \
-                                                    \
-    CL_DEBUG(what);                                 \
+#define CL_DEBUG_AT(level, what) do {                 \
+    if (!CL_DEBUG_MSGS || cl_debug_level() < (level)) \
+        break;                                        \
+                                                      \
+    CL_DEBUG(what);                                   \
 } while (0)
 
 /// same as CL_DEBUG_MSG, but compares current debug level with the given one
-#define CL_DEBUG_MSG_AT(level, loc, what) do {      \
-    if (cl_debug_level() < (level))                 \
-        break;                                      \
-                                                    \
-    CL_DEBUG_MSG(loc, what);                        \
+#define CL_DEBUG_MSG_AT(level, loc, what) do {        \
+    if (!CL_DEBUG_MSGS || cl_debug_level() < (level)) \
+        break;                                        \
+                                                      \
+    CL_DEBUG_MSG(loc, what);                          \
 } while (0)
 
 inline std::ostream& operator<<(std::ostream &str, const struct cl_loc &loc)
@@ -192,6 +208,26 @@ void cl_error(const char *msg);
  */
 void cl_note(const char *msg);
 
+/**
+ * start collecting warning/error messages (each of them together with the notes
+ * that follow it).  A diagnostic is emitted as soon as its notes are complete,
+ * if it is reached again with the same location, kind, message and backtrace
+ * (the notes without internal location), it is only counted.
+ *
+ * @param[in]  max_traces  Count of distinct diagnostics to emit along with
+ *                         their notes (backtraces), negative means unlimited
+ */
+void cl_msg_collect_start(int max_traces);
+
+/**
+ * emit the last diagnostic collected since cl_msg_collect_start(), the counts
+ * of the diagnostics reached more than once, and stop collecting
+ *
+ * @param[in]  report_file  If not NULL, write also a report with one JSON
+ *                          object per each distinct diagnostic into the file
+ */
+void cl_msg_collect_flush(const char *report_file);
+
 /**
  * emit raw fatal error and ask cl peer to shoot down the process
  *
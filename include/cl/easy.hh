@@ -35,6 +35,8 @@ namespace CodeStorage {
  * the analyzed code (for read-only access)
  * @param configString a custom configuration string passed from the gcc
  * command-line (or another code parser that is used as gcc replacement)
+ * @note The function may be called repeatedly within a single process, each
+ * call starts with the configuration given by its own configString.
  */
 extern void clEasyRun(
         const CodeStorage::Storage      &stor,
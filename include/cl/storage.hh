@@ -532,6 +532,12 @@ class Block {
         /// return true, if a loop at the level of CFG starts with this block
         bool isLoopEntry() const;
 
+        /**
+         * return true, if the block has a single predecessor and is not a loop
+         * entry, i.e. it continues the extended basic block of its predecessor
+         */
+        bool isEbbInterior() const;
+
     private:
         TList insns_;
         TTargetList inbound_;
@@ -651,7 +657,7 @@ class Item {
 };
 
 typedef std::vector<const Item *>       TItemList;
-typedef std::set<Node *>                TNodeList;
+typedef std::vector<Node *>             TNodeList;
 
 class Node {
     public:
@@ -665,6 +671,8 @@ class Node {
         TNodeList                       outNodes;
         /// in-edges are just 'synced' pointers
         TNodeList                       inNodes;
+        /// union-find link to the node this one was joined into (or NULL)
+        Node                           *joinedTo;
         /// there should be only one black-hole / graph
         bool                            isBlackHole;
 };
@@ -0,0 +1,172 @@
+/*
+ * Copyright (C) 2026 agent <agent@local>
+ *
+ * This file is part of predator.
+ *
+ * predator is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * any later version.
+ *
+ * predator is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with predator.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "config.h"
+#include "budget.hh"
+
+#include <cl/cl_msg.hh>
+#include <cl/memdebug.hh>
+#include <cl/stopwatch.hh>
+
+#include "glconf.hh"
+
+#include <stdexcept>
+
+/// count of check() calls per measurement, mallinfo() is not for free
+#define BUDGET_CHECK_PERIOD                 0x40
+
+/// precision of the analysis, each stage includes the previous ones
+enum EBudgetStage {
+    BS_FULL = 0,            ///< run-time options as configured by the user
+    BS_JOIN,                ///< unrestricted three-way join, no containers
+    BS_WIDEN,               ///< earlier state pruning, no integral arithmetic
+    BS_JOIN_ALL,            ///< join states on each basic block entry
+    BS_EXHAUSTED            ///< no budget left, terminate the analysis
+};
+
+struct BudgetState {
+    bool            enabled;
+    StopWatch       watch;
+    EBudgetStage    stage;
+    unsigned        cntChecks;
+    bool            errorReported;
+};
+
+static BudgetState budget;
+
+void AnalysisBudget::start()
+{
+    budget.enabled = GlConf::data.timeBudget || GlConf::data.memBudget;
+    budget.watch.reset();
+    budget.stage = BS_FULL;
+    budget.cntChecks = 0U;
+    budget.errorReported = false;
+}
+
+bool AnalysisBudget::enabled()
+{
+    return budget.enabled;
+}
+
+/// return the drained portion of the budget (1 means exhausted)
+static float drainedBudget()
+{
+    float ratio = 0.0;
+
+    const int timeBudget = GlConf::data.timeBudget;
+    if (timeBudget)
+        ratio = budget.watch.elapsed() / timeBudget;
+
+    const int memBudget = GlConf::data.memBudget;
+    ssize_t cb;
+    if (memBudget && currentMemUsage(&cb)) {
+        const float mib = static_cast<float>(cb) / (1U << /* MiB */ 20);
+        const float memRatio = mib / memBudget;
+        if (ratio < memRatio)
+            ratio = memRatio;
+    }
+
+    return ratio;
+}
+
+static EBudgetStage stageByRatio(const float ratio)
+{
+    if (1.0 <= ratio)
+        return BS_EXHAUSTED;
+    if (0.875 <= ratio)
+        return BS_JOIN_ALL;
+    if (0.75 <= ratio)
+        return BS_WIDEN;
+    if (0.5 <= ratio)
+        return BS_JOIN;
+
+    return BS_FULL;
+}
+
+/// all the changes over-approximate, so that the analysis remains sound
+static void enterStage(const EBudgetStage stage)
+{
+    GlConf::Options &data = GlConf::data;
+
+    switch (stage) {
+        case BS_FULL:
+            break;
+
+        case BS_JOIN:
+            data.allowThreeWayJoin = 3;
+            data.detectContainers = false;
+            break;
+
+        case BS_WIDEN:
+            if (!data.statePruningTotalThr || 0x20 < data.statePruningTotalThr)
+                data.statePruningTotalThr = 0x20;
+            data.intArithmeticLimit = /* disabled */ 0;
+            break;
+
+        case BS_JOIN_ALL:
+            data.joinOnLoopEdgesOnly = /* join on each block entry */ 0;
+            break;
+
+        case BS_EXHAUSTED:
+            throw std::runtime_error("analysis budget exhausted");
+    }
+}
+
+void AnalysisBudget::check()
+{
+    if (!budget.enabled || (++budget.cntChecks % BUDGET_CHECK_PERIOD))
+        return;
+
+    const float ratio = drainedBudget();
+    const EBudgetStage target = stageByRatio(ratio);
+    while (budget.stage < target) {
+        budget.stage = static_cast<EBudgetStage>(budget.stage + 1);
+        CL_DEBUG("analysis budget drained to " << static_cast<int>(100 * ratio)
+                << "%, entering precision stage " << budget.stage);
+
+        enterStage(budget.stage);
+    }
+}
+
+void AnalysisBudget::errorReported()
+{
+    budget.errorReported = true;
+}
+
+bool AnalysisBudget::anyErrorReported()
+{
+    return budget.errorReported;
+}
+
+void AnalysisBudget::printVerdict(bool complete)
+{
+    if (!budget.enabled || budget.errorReported)
+        // the reported errors speak for themselves
+        return;
+
+    if (BS_EXHAUSTED == budget.stage)
+        CL_WARN("analysis budget exhausted, the result is unknown");
+    else if (!complete)
+        CL_WARN("the analysis has not completed, the result is unknown");
+    else if (BS_FULL != budget.stage)
+        CL_NOTE("no error found under abstraction "
+                "(precision degraded to fit the analysis budget)");
+    else
+        CL_NOTE("no error found under abstraction");
+}
@@ -0,0 +1,59 @@
+/*
+ * Copyright (C) 2026 agent <agent@local>
+ *
+ * This file is part of predator.
+ *
+ * predator is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * any later version.
+ *
+ * predator is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with predator.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef H_GUARD_BUDGET_H
+#define H_GUARD_BUDGET_H
+
+/**
+ * @file budget.hh
+ * AnalysisBudget - time/memory budget of a single run of the analysis
+ */
+
+/**
+ * As the budget given by the time_budget/mem_budget options drains, the
+ * remaining work is done with cheaper (but still sound) settings of GlConf.
+ * As soon as the budget is exhausted, the analysis is terminated and its
+ * result is reported as unknown.
+ */
+class AnalysisBudget {
+    public:
+        /// (re)start measuring according to GlConf::data, no-op if no budget
+        static void start();
+
+        /// true if a budget has been given for the current run
+        static bool enabled();
+
+        /// degrade precision if needed, throws std::runtime_error on exhaustion
+        static void check();
+
+        /// to be called each time the analysis reports an error
+        static void errorReported();
+
+        /// true if the analysis has reported an error since start()
+        static bool anyErrorReported();
+
+        /// print the verdict of the just completed (or terminated) run
+        static void printVerdict(bool complete);
+
+    private:
+        /// library class
+        AnalysisBudget();
+};
+
+#endif /* H_GUARD_BUDGET_H */
@@ -23,10 +23,17 @@
 #include <cl/cl_msg.hh>
 #include <cl/clutil.hh>
 #include <cl/memdebug.hh>
+#include <cl/stopwatch.hh>
 #include <cl/storage.hh>
 
+#include "budget.hh"
 #include "fixed_point_proxy.hh"
 #include "glconf.hh"
+#include "mempool.hh"
+#include "microbench.hh"
+#include "perfstats.hh"
+#include "plotsink.hh"
+#include "portfolio.hh"
 #include "symbt.hh"
 #include "symdump.hh"
 #include "symexec.hh"
@@ -110,6 +117,23 @@ void execFnc(const CodeStorage::Fnc &fnc, bool lookForGlJunk = false)
     }
 }
 
+void replayFnc(const CodeStorage::Fnc &fnc, const std::string &logFile)
+{
+    TReplayPath path;
+    if (!readReplayPath(&path, fnc, logFile))
+        return;
+
+    // create the initial configuration the same way as execFnc() does
+    Trace::RootNode *traceRoot = new Trace::RootNode(&fnc);
+    SymHeap entry(*fnc.stor, traceRoot);
+#if SE_DISABLE_SYMCUT
+    initGlVars(entry);
+#endif
+
+    replayPath(entry, fnc, path);
+    printMemUsage("replayPath");
+}
+
 void execVirtualRoots(const CodeStorage::Storage &stor)
 {
     namespace CG = CodeStorage::CallGraph;
@@ -154,33 +178,51 @@ void launchSymExec(const CodeStorage::Storage &stor)
         return;
     }
 
+    if (!GlConf::data.replayPath.empty()) {
+        // re-execute a single recorded path through main() instead
+        replayFnc(*main, GlConf::data.replayPath);
+        return;
+    }
+
     // just execute the main() function
     execFnc(*main, /* lookForGlJunk */ true);
     printMemUsage("execFnc");
 }
 
-// /////////////////////////////////////////////////////////////////////////////
-// see easy.hh for details
-void clEasyRun(const CodeStorage::Storage &stor, const char *configString)
+/// run the analysis with the given config string, return false if it failed
+bool runSymExec(const CodeStorage::Storage &stor, const std::string &conf)
 {
-    initSymDump(stor);
-
-    // read parameters of symbolic execution
-    GlConf::loadConfigString(configString);
+    // read parameters of symbolic execution (start from the defaults in case
+    // we are called more than once from a single process)
+    GlConf::resetOptions();
+    GlConf::loadConfigString(conf);
+    if (GlConf::data.dedupMsgs)
+        cl_msg_collect_start(GlConf::data.msgMaxTraces);
+
+    // start measuring the time/memory budget if any
+    AnalysisBudget::start();
+    resetPerfStats();
+    StopWatch watch;
 
     // run symbolic execution
+    bool ok = true;
     try {
         launchSymExec(stor);
     }
     catch (const std::runtime_error &e) {
         CL_DEBUG("clEasyRun() caught a run-time exception: " << e.what());
+        ok = false;
     }
 
+    // time the core heap operations over the captured heaps if enabled
+    microBenchRun();
+
     FixedPoint::StateByInsn *const fixedPoint = GlConf::data.fixedPoint;
     if (fixedPoint) {
         // plot fixed-point
         fixedPoint->plotAll();
         delete fixedPoint;
+        GlConf::data.fixedPoint = 0;
         printMemUsage("FixedPoint::StateByInsn::~StateByInsn");
     }
 
@@ -194,5 +236,46 @@ void clEasyRun(const CodeStorage::Storage &stor, const char *configString)
         printMemUsage("Trace::Globals::cleanup");
     }
 
+    // give the slabs of heap entities and trace nodes back if nothing uses them
+    MemPool::releaseUnused();
+
+    if (GlConf::data.dedupMsgs) {
+        // emit the deduplicated errors/warnings now
+        const std::string &report = GlConf::data.msgReport;
+        cl_msg_collect_flush((report.empty()) ? 0 : report.c_str());
+    }
+
+    // flush all pending graphs if they go to the plot archive
+    PlotSink::close();
+
+    // report the result of a budget-aware run, the deadline may have been hit
+    AnalysisBudget::printVerdict(ok);
+
+    if (!GlConf::data.perfStats.empty())
+        writePerfStats(GlConf::data.perfStats, watch.elapsed());
+
+    return ok;
+}
+
+/// run the analysis (possibly a portfolio of its variants), false if it failed
+bool runAnalysis(const CodeStorage::Storage &stor, const std::string &conf)
+{
+    std::string baseConf(conf);
+    std::string variants;
+    if (!extractPortfolio(&baseConf, &variants))
+        return runSymExec(stor, conf);
+
+    // run several configurations concurrently, the first one wins
+    return runPortfolio(stor, baseConf, variants, runSymExec);
+}
+
+// /////////////////////////////////////////////////////////////////////////////
+// see easy.hh for details
+void clEasyRun(const CodeStorage::Storage &stor, const char *configString)
+{
+    initSymDump(stor);
+
+    runAnalysis(stor, configString);
+
     printPeakMemUsage();
 }
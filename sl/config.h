@@ -146,11 +146,23 @@
  */
 #define SE_BLOCK_SCHEDULER_KIND             2
 
+/**
+ * estimated count of bytes per one heap entity, used to charge the entries of
+ * call cache against its budget (see the call_cache_budget option)
+ */
+#define SE_CALL_CACHE_ENT_SIZE              0x80
+
 /**
  * call cache miss count that will trigger function removal (0 means disabled)
  */
 #define SE_CALL_CACHE_MISS_THR              0x10
 
+/**
+ * renumber heap entities on a basic block boundary as soon as lastId() exceeds
+ * the count of valid IDs N times (0 means disabled) [experimental]
+ */
+#define SE_COMPACT_HEAP_IDS_THR             0
+
 /**
  * increase the cost of abstraction path consisting of concrete objects only by
  */
@@ -226,6 +238,23 @@
  */
 #define SE_EXIT_LEAKS                       0
 
+/**
+ * if 1, carry heaps through extended basic blocks (chains of blocks with a
+ * single predecessor) without looking for them in the states of the blocks,
+ * which then keep state info only while needed (see SE_STATE_PRUNING_MODE).
+ * The isomorphic heaps are not merged until the next merge point or loop entry
+ * then, so it needs to be evaluated on the regression tests [experimental]
+ * @note This takes effect only while the join_on_loop_edges_only run-time
+ * option is 3 or more (see SE_JOIN_ON_LOOP_EDGES_ONLY)
+ */
+#define SE_EXTENDED_BASIC_BLOCKS            0
+
+/**
+ * count of heaps captured per instruction by dump_fixed_point before they are
+ * joined into the fixed-point of that instruction (0 means join at the end)
+ */
+#define SE_FIXED_POINT_CAPTURE_THR          0x100
+
 /**
  * if non-zero, do not replace a previously tracked if entailed by a new one
  */
@@ -257,6 +286,7 @@
 
 /**
  * preserve heaps with different DLS minimum lengths up to the specified number
+ * @note This is not applied at loop entries widened by SE_WIDEN_AFTER_ROUNDS
  */
 #define SE_PRESERVE_DLS_MINLEN              2
 
@@ -302,6 +332,15 @@
  */
 #define SE_SYMCUT_PRESERVES_MIN_LENGTHS     1
 
+/**
+ * - 0 ... record only the trace graph nodes the analysis itself depends on
+ * - 1 ... record also branching on conditions (reduced traces, which show
+ *           the path to an error without the instructions along the path)
+ * - 2 ... record also each executed instruction (complete traces)
+ * @note This can be overridden by the trace_level run-time option
+ */
+#define SE_TRACE_LEVEL                      2
+
 /**
  * - 0 ... disable tracking non-pointer values
  * - 1 ... basic tracking of non-pointer values
@@ -310,6 +349,14 @@
  */
 #define SE_TRACK_NON_POINTER_VALUES         2
 
+/**
+ * count of changes of a loop entry state (via loop-closing edges) after which
+ * the join at that loop entry ignores SE_INT_ARITHMETIC_LIMIT and allows to
+ * join different DLS minimal lengths (0 means disabled)
+ * @note This can be overridden by the widen_after run-time option
+ */
+#define SE_WIDEN_AFTER_ROUNDS               0
+
 /**
  * if 1, do not make deep copy on copy of SymHeap [experimental]
  */
@@ -320,11 +367,22 @@
  */
 #define SH_DELAYED_FIELDS_DESTRUCTION       1
 
+/**
+ * count of entity slots per copy-on-write chunk of EntStore (power of two)
+ */
+#define SH_ENT_CHUNK_SIZE                   0x40
+
 /**
  * if 1, prevent collisions on entity IDs with descendants heaps
  */
 #define SH_PREVENT_AMBIGUOUS_ENT_ID         1
 
+/**
+ * if 1, allocate heap entities and trace graph nodes from MemPool slabs, use 0
+ * to pass each allocation to operator new, e.g. when debugging with valgrind
+ */
+#define SH_USE_MEM_POOL                     1
+
 /**
  * if more than zero, jump to debugger as soon as N graph of the same name has
  * been plotted
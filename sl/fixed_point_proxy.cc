@@ -28,6 +28,8 @@
 #include "cont_shape_var.hh"
 #include "fixed_point.hh"
 #include "glconf.hh"
+#include "plotenum.hh"
+#include "plotsink.hh"
 #include "symplot.hh"
 #include "symtrace.hh"
 
@@ -35,7 +37,6 @@
 #include <cl/cldebug.hh>
 #include <cl/storage.hh>
 
-#include <fstream>
 #include <iomanip>
 #include <map>
 
@@ -49,11 +50,34 @@ typedef std::map<TFncUid, TFnc>                     TFncMap;
 
 typedef const CodeStorage::Block                   *TBlock;
 
+typedef std::map<TInsn, SymHeapList>               TPendingMap;
+
 struct StateByInsn::Private {
     TFncMap             visitedFncs;
     TStateMap           stateByInsn;
+    TPendingMap         pending;
+
+    void joinPending(TInsn insn, SymHeapList &heaps);
+    void joinAllPending();
 };
 
+void StateByInsn::Private::joinPending(const TInsn insn, SymHeapList &heaps)
+{
+    SymStateWithJoin &state = this->stateByInsn[insn];
+    for (const SymHeap *sh : heaps)
+        state.insert(*sh, /* allowThreeWay */ false);
+
+    heaps.clear();
+}
+
+void StateByInsn::Private::joinAllPending()
+{
+    for (TPendingMap::reference item : this->pending)
+        this->joinPending(item.first, item.second);
+
+    this->pending.clear();
+}
+
 StateByInsn::StateByInsn():
     d(new Private)
 {
@@ -64,22 +88,30 @@ StateByInsn::~StateByInsn()
     delete d;
 }
 
-bool /* any change */ StateByInsn::insert(const TInsn insn, const SymHeap &sh)
+void StateByInsn::insert(const TInsn insn, const SymHeap &sh)
 {
-    SymStateWithJoin &state = d->stateByInsn[insn];
+    SymHeapList &heaps = d->pending[insn];
 
-    if (!state.size()) {
+    if (!heaps.size() && !hasKey(d->stateByInsn, insn)) {
         // update the map of visited functions
         const TFnc fnc = fncByCfg(insn->bb->cfg());
         const TFncUid uid = uidOf(*fnc);
         d->visitedFncs[uid] = fnc;
     }
 
-    return state.insert(sh, /* allowThreeWay */ false);
+    // just remember the heap, SymHeapList does no lookup on insertion
+    heaps.insert(sh);
+
+#if SE_FIXED_POINT_CAPTURE_THR
+    if (SE_FIXED_POINT_CAPTURE_THR <= heaps.size())
+        // do not let the captured heaps grow without bounds
+        d->joinPending(insn, heaps);
+#endif
 }
 
 const StateByInsn::TStateMap& StateByInsn::stateMap() const
 {
+    d->joinAllPending();
     return d->stateByInsn;
 }
 
@@ -407,17 +439,19 @@ void plotFixedPointOfFnc(PlotData &plot, const GlobalState &fncState)
 void plotFnc(const TFnc fnc, StateByInsn::TStateMap &stateByInsn)
 {
     const std::string fncName = nameOf(*fnc);
-    std::string plotName("fp-");
-    plotName += fncName;
+    const std::string plotName =
+        PlotEnumerator::instance()->withNamespace("fp-" + fncName);
 
-    // create a dot file
-    const std::string fileName(plotName + ".dot");
-    std::fstream out(fileName.c_str(), std::ios::out);
-    if (!out) {
+    // create a dot file (or a record in the plot archive)
+    PlotStream str(plotName);
+    const std::string &fileName = str.dest();
+    if (!str.ok()) {
         CL_ERROR("unable to create file '" << fileName << "'");
         return;
     }
 
+    std::ostream &out = str.out();
+
     // open graph
     out << "digraph " << QUOT(plotName)
         << " {\n\tlabel=<<FONT POINT-SIZE=\"36\">" << fncName
@@ -431,9 +465,8 @@ void plotFnc(const TFnc fnc, StateByInsn::TStateMap &stateByInsn)
 
     // close graph
     out << "}\n";
-    if (!out)
+    if (!str.commit())
         CL_ERROR("unable to write file '" << fileName << "'");
-    out.close();
 }
 
 void StateByInsn::plotAll()
@@ -442,6 +475,9 @@ void StateByInsn::plotAll()
         // nothing to plot
         return;
 
+    // join the heaps captured during the analysis
+    d->joinAllPending();
+
     // obtain a reference to CodeStorage::Storage
     TStorRef stor = *d->visitedFncs.begin()->second->stor;
 
@@ -39,8 +39,10 @@ namespace FixedPoint {
             StateByInsn();
             ~StateByInsn();
 
-            bool /* any change */ insert(TInsn insn, const SymHeap &sh);
+            /// capture the heap, the join is deferred until it is needed
+            void insert(TInsn insn, const SymHeap &sh);
 
+            /// join all captured heaps and return the resulting fixed-point
             const TStateMap& stateMap() const;
 
             void plotAll();
@@ -21,6 +21,7 @@
 #include "glconf.hh"
 
 #include "fixed_point_proxy.hh"
+#include "plotenum.hh"
 
 #include <cl/cl_msg.hh>
 
@@ -51,6 +52,15 @@ Options::Options():
     stateLiveOrdering(SE_STATE_ON_THE_FLY_ORDERING),
     exitLeaks(SE_EXIT_LEAKS),
     detectContainers(false),
+    traceLevel(SE_TRACE_LEVEL),
+    statePruningTotalThr(SE_STATE_PRUNING_TOTAL_THR),
+    widenAfter(SE_WIDEN_AFTER_ROUNDS),
+    timeBudget(0),
+    memBudget(0),
+    callCacheBudget(0),
+    dedupMsgs(false),
+    msgMaxTraces(-1),
+    microBench(0),
     fixedPoint(0)
 {
 }
@@ -189,6 +199,79 @@ void handleMemLeakIsError(const string &name, const string &value)
     data.memLeakIsError = true;
 }
 
+void handleMemBudget(const string &name, const string &value)
+{
+    try {
+        data.memBudget = boost::lexical_cast<unsigned>(value);
+    }
+    catch (...) {
+        CL_WARN("ignoring option \"" << name << "\" with invalid value");
+    }
+}
+
+void handleTimeBudget(const string &name, const string &value)
+{
+    try {
+        data.timeBudget = boost::lexical_cast<unsigned>(value);
+    }
+    catch (...) {
+        CL_WARN("ignoring option \"" << name << "\" with invalid value");
+    }
+}
+
+void handleCallCacheBudget(const string &name, const string &value)
+{
+    try {
+        data.callCacheBudget = boost::lexical_cast<unsigned>(value);
+    }
+    catch (...) {
+        CL_WARN("ignoring option \"" << name << "\" with invalid value");
+    }
+}
+
+void handleDedupMsgs(const string &name, const string &value)
+{
+    assumeNoValue(name, value);
+    data.dedupMsgs = true;
+}
+
+void handleMsgMaxTraces(const string &name, const string &value)
+{
+    try {
+        data.msgMaxTraces = boost::lexical_cast<unsigned>(value);
+        data.dedupMsgs = true;
+    }
+    catch (...) {
+        CL_WARN("ignoring option \"" << name << "\" with invalid value");
+    }
+}
+
+void handleMicroBench(const string &name, const string &value)
+{
+    if (value.empty()) {
+        data.microBench = /* default count of runs */ 10;
+        return;
+    }
+
+    try {
+        data.microBench = boost::lexical_cast<unsigned>(value);
+    }
+    catch (...) {
+        CL_WARN("ignoring option \"" << name << "\" with invalid value");
+    }
+}
+
+void handleMsgReport(const string &name, const string &value)
+{
+    if (value.empty()) {
+        CL_WARN("ignoring option \"" << name << "\" without a valid value");
+        return;
+    }
+
+    data.msgReport = value;
+    data.dedupMsgs = true;
+}
+
 void handleNoErrorRecovery(const string &name, const string &value)
 {
     assumeNoValue(name, value);
@@ -213,12 +296,86 @@ void handleNoPlot(const string &name, const string &value)
     data.skipUserPlots = true;
 }
 
+void handlePlotNamespace(const string &name, const string &value)
+{
+    if (value.empty()) {
+        CL_WARN("ignoring option \"" << name << "\" without a valid value");
+        return;
+    }
+
+    PlotEnumerator::instance()->setNamespace(value);
+}
+
+void handlePlotArchive(const string &name, const string &value)
+{
+    if (value.empty()) {
+        CL_WARN("ignoring option \"" << name << "\" without a valid value");
+        return;
+    }
+
+    data.plotArchive = value;
+}
+
+void handlePerfStats(const string &name, const string &value)
+{
+    if (value.empty()) {
+        CL_WARN("ignoring option \"" << name << "\" without a valid value");
+        return;
+    }
+
+    data.perfStats = value;
+}
+
+void handleDecisionLog(const string &name, const string &value)
+{
+    if (value.empty()) {
+        CL_WARN("ignoring option \"" << name << "\" without a valid value");
+        return;
+    }
+
+    data.decisionLog = value;
+}
+
+void handleReplayPath(const string &name, const string &value)
+{
+    if (value.empty()) {
+        CL_WARN("ignoring option \"" << name << "\" without a valid value");
+        return;
+    }
+
+    data.replayPath = value;
+}
+
 void handleOOM(const string &name, const string &value)
 {
     assumeNoValue(name, value);
     data.oomSimulation = true;
 }
 
+void handleTraceLevel(const string &name, const string &value)
+{
+    try {
+        data.traceLevel = boost::lexical_cast<int>(value);
+        if (data.traceLevel < 0)
+            data.traceLevel = 0;
+        if (data.traceLevel > 2)
+            data.traceLevel = 2;
+    }
+    catch (...) {
+        CL_WARN("ignoring option \"" << name << "\" with invalid value");
+    }
+}
+
+void handleWidenAfter(const string &name, const string &value)
+{
+    try {
+        data.widenAfter = boost::lexical_cast<unsigned>(value);
+    }
+    catch (...) {
+        CL_WARN("ignoring option \"" << name << "\" with invalid value");
+    }
+}
+
 void handleTrackUninit(const string &name, const string &value)
 {
     assumeNoValue(name, value);
@@ -245,7 +402,10 @@ ConfigStringParser::ConfigStringParser()
 {
     tbl_["allow_cyclic_trace_graph"]= handleAllowCyclicTraceGraph;
     tbl_["allow_three_way_join"]    = handleAllowThreeWayJoin;
+    tbl_["call_cache_budget"]       = handleCallCacheBudget;
     tbl_["dump_fixed_point"]        = handleDumpFixedPoint;
+    tbl_["decision_log"]            = handleDecisionLog;
+    tbl_["dedup_msgs"]              = handleDedupMsgs;
     tbl_["detect_containers"]       = handleDetectContainers;
     tbl_["error_label"]             = handleErrorLabel;
     tbl_["exit_leaks"]              = handleExitLeaks;
@@ -253,13 +413,24 @@ ConfigStringParser::ConfigStringParser()
     tbl_["full_error_recovery"]     = handleFullErrorRecovery;
     tbl_["int_arithmetic_limit"]    = handleIntArithmeticLimit;
     tbl_["join_on_loop_edges_only"] = handleJoinOnLoopEdgesOnly;
+    tbl_["mem_budget"]              = handleMemBudget;
     tbl_["memleak_is_error"]        = handleMemLeakIsError;
+    tbl_["micro_bench"]             = handleMicroBench;
+    tbl_["msg_max_traces"]          = handleMsgMaxTraces;
+    tbl_["msg_report"]              = handleMsgReport;
     tbl_["no_error_recovery"]       = handleNoErrorRecovery;
     tbl_["no_plot"]                 = handleNoPlot;
     tbl_["oom"]                     = handleOOM;
+    tbl_["perf_stats"]              = handlePerfStats;
+    tbl_["plot_archive"]            = handlePlotArchive;
+    tbl_["plot_namespace"]          = handlePlotNamespace;
+    tbl_["replay_path"]             = handleReplayPath;
     tbl_["state_live_ordering"]     = handleStateLiveOrdering;
+    tbl_["time_budget"]             = handleTimeBudget;
+    tbl_["trace_level"]             = handleTraceLevel;
     tbl_["track_uninit"]            = handleTrackUninit;
     tbl_["verifier_error_is_error"] = handleVerifierErrorIsError;
+    tbl_["widen_after"]             = handleWidenAfter;
 }
 
 void ConfigStringParser::handleRawOption(const string &raw) const
@@ -289,6 +460,13 @@ void ConfigStringParser::handleRawOption(const string &raw) const
     hdl(name, value);
 }
 
+void resetOptions()
+{
+    CL_BREAK_IF(data.fixedPoint);
+    data = Options();
+    PlotEnumerator::instance()->setNamespace("");
+}
+
 void loadConfigString(const string &cnf)
 {
     if (cnf.empty())
@@ -304,4 +482,35 @@ void loadConfigString(const string &cnf)
         parser.handleRawOption(str);
 }
 
+bool extractOption(string *pConf, const string &name, string *pValue)
+{
+    const string prefix = name + ":";
+
+    std::vector<string> opts;
+    boost::split(opts, *pConf, boost::algorithm::is_any_of(","));
+
+    bool found = false;
+    string conf;
+    for (const string &opt : opts) {
+        if (0 == opt.compare(0, prefix.size(), prefix)) {
+            *pValue = opt.substr(prefix.size());
+            found = true;
+            continue;
+        }
+
+        if (opt.empty())
+            continue;
+
+        if (!conf.empty())
+            conf += ",";
+
+        conf += opt;
+    }
+
+    if (found)
+        *pConf = conf;
+
+    return found;
+}
+
 } // namespace GlConf
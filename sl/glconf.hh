@@ -46,6 +46,20 @@ struct Options {
     int stateLiveOrdering;  ///< @copydoc config.h::SE_STATE_ON_THE_FLY_ORDERING
     bool exitLeaks;         ///< @copydoc config.h::SE_EXIT_LEAKS
     bool detectContainers;  ///< detect containers and operations over them
+    int traceLevel;         ///< @copydoc config.h::SE_TRACE_LEVEL
+    int statePruningTotalThr; ///< @copydoc config.h::SE_STATE_PRUNING_TOTAL_THR
+    int widenAfter;         ///< @copydoc config.h::SE_WIDEN_AFTER_ROUNDS
+    int timeBudget;         ///< CPU time budget in seconds (0 means unlimited)
+    int memBudget;          ///< memory budget in MiB (0 means unlimited)
+    int callCacheBudget;    ///< call cache budget in KiB (0 means unlimited)
+    bool dedupMsgs;         ///< collect and deduplicate errors/warnings
+    int msgMaxTraces;       ///< count of deduplicated messages with notes
+    int microBench;         ///< runs of the micro-benchmark (0 means disabled)
+    std::string msgReport;  ///< if not empty, write JSON lines report there
+    std::string plotArchive;///< if not empty, write all graphs into the archive
+    std::string perfStats;  ///< if not empty, write performance counters there
+    std::string replayPath; ///< if not empty, replay the path from the log only
+    std::string decisionLog;///< if not empty, write decision logs of errors
     FixedPoint::StateByInsn *fixedPoint;  ///< fixed-point plotter (0 if unused)
 
     Options();
@@ -53,8 +67,24 @@ struct Options {
 
 extern Options data;
 
+/// restore the defaults, so that a run does not inherit options of the previous
+void resetOptions();
+
 void loadConfigString(const std::string &);
 
+/**
+ * remove the option of the given name from the config string, the option is
+ * handled by the caller instead of loadConfigString()
+ * @param pConf the config string to update
+ * @param name name of the option to look for
+ * @param pValue where to store the value of the option
+ * @return true if the option has been found
+ */
+bool extractOption(
+        std::string                *pConf,
+        const std::string          &name,
+        std::string                *pValue);
+
 } // namespace GlConf
 
 #endif /* H_GUARD_GLCONF_H */
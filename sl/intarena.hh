@@ -21,6 +21,7 @@
 #define H_GUARD_INTARENA_H
 
 #include "config.h"
+#include "syments.hh"
 
 #include <map>
 #include <set>
@@ -44,7 +45,9 @@ class IntervalArena {
         typedef std::set<TFld>                      TLeaf;
         typedef std::map</* beg */ TInt, TLeaf>     TLine;
         typedef std::map</* end */ TInt, TLine>     TCont;
-        TCont                                       cont_;
+
+        /// shared among copies of the arena until written to
+        SharedCont<TCont>                           data_;
 
     public:
         void add(const key_type &, TFld);
@@ -56,7 +59,8 @@ class IntervalArena {
         void reverseLookup(TKeySet &dst, TFld) const;
 
         void clear() {
-            cont_.clear();
+            if (!data_.ro().empty())
+                data_.rw().clear();
         }
 
         IntervalArena& operator+=(const value_type &item) {
@@ -77,7 +81,17 @@ void IntervalArena<TInt, TFld>::add(const key_type &key, const TFld fld)
     const TInt end = key.second;
     CL_BREAK_IF(end <= beg);
 
-    cont_[end][beg].insert(fld);
+    // check whether the item is already there (saves cloning of shared data)
+    const TCont &contRO = data_.ro();
+    const typename TCont::const_iterator itEnd = contRO.find(end);
+    if (contRO.end() != itEnd) {
+        const TLine &line = itEnd->second;
+        const typename TLine::const_iterator itBeg = line.find(beg);
+        if (line.end() != itBeg && hasKey(itBeg->second, fld))
+            return;
+    }
+
+    data_.rw()[end][beg].insert(fld);
 }
 
 template <typename TInt, typename TFld>
@@ -89,9 +103,10 @@ void IntervalArena<TInt, TFld>::sub(const key_type &key, const TFld fld)
 
     std::vector<value_type> recoverList;
 
-    const typename TCont::iterator itEnd = cont_.end();
+    TCont &cont = data_.rw();
+    const typename TCont::iterator itEnd = cont.end();
     typename TCont::iterator it =
-        cont_.lower_bound(winBeg + /* right-open interval given as key */ 1);
+        cont.lower_bound(winBeg + /* right-open interval given as key */ 1);
 
     while (itEnd != it) {
         TLine &line = it->second;
@@ -159,7 +174,7 @@ void IntervalArena<TInt, TFld>::sub(const key_type &key, const TFld fld)
 #if IA_AGGRESSIVE_OPTIMIZATION
             if (line.empty()) {
                 // FIXME: Can we remove items from std::map during traversal??
-                cont_.erase(it++);
+                cont.erase(it++);
                 continue;
             }
 #endif
@@ -175,7 +190,7 @@ void IntervalArena<TInt, TFld>::sub(const key_type &key, const TFld fld)
         const TInt beg = key.first;
         const TInt end = key.second;
 
-        cont_[end][beg].insert(fld);
+        cont[end][beg].insert(fld);
     }
 }
 
@@ -186,10 +201,11 @@ void IntervalArena<TInt, TFld>::intersects(TSet &dst, const key_type &key) const
     const TInt winEnd = key.second;
     CL_BREAK_IF(winEnd <= winBeg);
 
+    const TCont &cont = data_.ro();
     typename TCont::const_iterator it =
-        cont_.lower_bound(winBeg + /* right-open interval given as key */ 1);
+        cont.lower_bound(winBeg + /* right-open interval given as key */ 1);
 
-    for (; cont_.end() != it; ++it) {
+    for (; cont.end() != it; ++it) {
         const TLine &line = it->second;
 #if !IA_AGGRESSIVE_OPTIMIZATION
         if (line.empty())
@@ -230,7 +246,7 @@ void IntervalArena<TInt, TFld>::reverseLookup(TKeySet &dst, const TFld fld)
 {
     key_type key;
 
-    for (typename TCont::const_reference item : cont_) {
+    for (typename TCont::const_reference item : data_.ro()) {
         key/* end */.second = item/* end */.first;
         const TLine &line = item.second;
 
@@ -249,8 +265,9 @@ template <typename TInt, typename TFld>
 void IntervalArena<TInt, TFld>::exactMatch(TSet &dst, const key_type &key) const
 {
     typedef typename TCont::const_iterator TEndIt;
-    const TEndIt itEnd = cont_.find(/* end */ key.second);
-    if (cont_.end() == itEnd)
+    const TCont &cont = data_.ro();
+    const TEndIt itEnd = cont.find(/* end */ key.second);
+    if (cont.end() == itEnd)
         // upper bound not found
         return;
 
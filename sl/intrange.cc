@@ -66,15 +66,10 @@ void chkRange(const Range &rng)
         CL_BREAK_IF(1 + rng.hi - rng.lo < rng.alignment);
 }
 
-TInt approxGCD(TInt a, TInt b)
+#ifndef NDEBUG
+// the original loop-based implementation, used to cross-check approxGCD()
+TInt approxGCDRef(TInt a, TInt b)
 {
-    CL_BREAK_IF(a < RZ_MIN || RZ_MAX < a);
-    CL_BREAK_IF(b < RZ_MIN || RZ_MAX < b);
-
-#if SE_DISABLE_ALIGNMENT_TRACKING
-    return Int1;
-#endif
-
     if (a < Int0)
         a = -a;
     if (b < Int0)
@@ -95,6 +90,33 @@ TInt approxGCD(TInt a, TInt b)
 
     return gcd;
 }
+#endif
+
+// count trailing zero bits of a non-zero number
+inline unsigned ctzOf(const TInt num)
+{
+    return __builtin_ctzll(static_cast<unsigned long long>(num));
+}
+
+TInt approxGCD(TInt a, TInt b)
+{
+    CL_BREAK_IF(a < RZ_MIN || RZ_MAX < a);
+    CL_BREAK_IF(b < RZ_MIN || RZ_MAX < b);
+
+#if SE_DISABLE_ALIGNMENT_TRACKING
+    return Int1;
+#endif
+
+    if (!a || !b)
+        return Int1;
+
+    // the greatest power of two that divides both numbers (the sign does not
+    // matter for trailing zeros)
+    const unsigned bits = std::min(ctzOf(a), ctzOf(b));
+    const TInt gcd = Int1 << bits;
+    CL_BREAK_IF(approxGCDRef(a, b) != gcd);
+    return gcd;
+}
 
 Range join(const Range &rng1, const Range &rng2)
 {
@@ -333,13 +355,8 @@ TInt maskToAlignment(TInt mask)
         return Int1;
     }
 
-    TInt alignment = Int1;
-    while (!(mask & 1)) {
-        alignment <<= 1;
-        mask >>= 1;
-    }
-
-    return alignment;
+    // the lowest bit set in the mask
+    return Int1 << ctzOf(mask);
 }
 
 TInt extendSignedIntFromLeft(TInt num)
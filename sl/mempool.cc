@@ -0,0 +1,122 @@
+/*
+ * Copyright (C) 2026 agent <agent@local>
+ *
+ * This file is part of predator.
+ *
+ * predator is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * any later version.
+ *
+ * predator is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with predator.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "config.h"
+#include "mempool.hh"
+
+#include <cl/cl_msg.hh>
+
+#include <new>
+
+// /////////////////////////////////////////////////////////////////////////////
+// implementation of MemPool
+MemPool *MemPool::pools_;
+
+MemPool::MemPool(unsigned long *pCntMallocs):
+    pCntMallocs_(pCntMallocs),
+    slabs_(0),
+    slabPtr_(0),
+    slabLeft_(0),
+    cntUsed_(0),
+    next_(pools_)
+{
+    for (FreeNode *&head : freeList_)
+        head = 0;
+
+    pools_ = this;
+}
+
+void* MemPool::alloc(const size_t size)
+{
+    if (!SH_USE_MEM_POOL || maxSize < size) {
+        if (pCntMallocs_)
+            ++(*pCntMallocs_);
+
+        return ::operator new(size);
+    }
+
+    ++cntUsed_;
+    const size_t idx = (size + grain - 1) / grain;
+    FreeNode *&head = freeList_[idx];
+    if (head) {
+        // reuse a previously released block of the same size class
+        FreeNode *node = head;
+        head = node->next;
+        return node;
+    }
+
+    const size_t rounded = idx * grain;
+    if (slabLeft_ < rounded) {
+        // allocate a new slab and keep it linked until releaseSlabs()
+        if (pCntMallocs_)
+            ++(*pCntMallocs_);
+
+        FreeNode *slab = static_cast<FreeNode *>(::operator new(slabSize));
+        slab->next = slabs_;
+        slabs_ = slab;
+        slabPtr_ = reinterpret_cast<char *>(slab) + grain;
+        slabLeft_ = slabSize - grain;
+    }
+
+    void *ptr = slabPtr_;
+    slabPtr_ += rounded;
+    slabLeft_ -= rounded;
+    return ptr;
+}
+
+void MemPool::release(void *ptr, const size_t size)
+{
+    if (!SH_USE_MEM_POOL || maxSize < size) {
+        ::operator delete(ptr);
+        return;
+    }
+
+    CL_BREAK_IF(!cntUsed_);
+    --cntUsed_;
+
+    const size_t idx = (size + grain - 1) / grain;
+    FreeNode *node = static_cast<FreeNode *>(ptr);
+    node->next = freeList_[idx];
+    freeList_[idx] = node;
+}
+
+void MemPool::releaseSlabs()
+{
+    CL_BREAK_IF(cntUsed_);
+
+    // the free lists point into the slabs
+    for (FreeNode *&head : freeList_)
+        head = 0;
+
+    while (slabs_) {
+        FreeNode *slab = slabs_;
+        slabs_ = slab->next;
+        ::operator delete(slab);
+    }
+
+    slabPtr_ = 0;
+    slabLeft_ = 0;
+}
+
+void MemPool::releaseUnused()
+{
+    for (MemPool *pool = pools_; pool; pool = pool->next_)
+        if (!pool->cntUsed_)
+            pool->releaseSlabs();
+}
@@ -0,0 +1,73 @@
+/*
+ * Copyright (C) 2026 agent <agent@local>
+ *
+ * This file is part of predator.
+ *
+ * predator is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * any later version.
+ *
+ * predator is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with predator.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef H_GUARD_MEM_POOL_H
+#define H_GUARD_MEM_POOL_H
+
+/**
+ * @file mempool.hh
+ * MemPool - recycles memory of small objects that are allocated very often
+ */
+
+#include <cstddef>
+
+/**
+ * size-class free lists carved out of big slabs (not meant to be thread-safe)
+ * @note with SH_USE_MEM_POOL set to 0, each block goes to operator new/delete
+ */
+class MemPool {
+    public:
+        /// if pCntMallocs is given, it counts the calls of operator new
+        explicit MemPool(unsigned long *pCntMallocs = 0);
+
+        void* alloc(size_t size);
+        void release(void *ptr, size_t size);
+
+        /// give the slabs of all pools with no block in use back to the system
+        static void releaseUnused();
+
+    private:
+        // allocation granularity and the biggest size handled by the pool
+        static const size_t grain       = 2 * sizeof(void *);
+        static const size_t maxSize     = 0x100;
+        static const size_t slabSize    = 0x10000;
+
+        struct FreeNode {
+            FreeNode       *next;
+        };
+
+        FreeNode           *freeList_[maxSize / grain + 1];
+        unsigned long      *pCntMallocs_;
+        FreeNode           *slabs_;
+        char               *slabPtr_;
+        size_t              slabLeft_;
+        size_t              cntUsed_;
+
+        // all pools are linked together for releaseUnused()
+        static MemPool     *pools_;
+        MemPool            *next_;
+
+        void releaseSlabs();
+
+        // the pool owns its slabs and is linked by address, it cannot be copied
+        MemPool(const MemPool &);
+        MemPool& operator=(const MemPool &);
+};
+
+#endif /* H_GUARD_MEM_POOL_H */
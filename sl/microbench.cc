@@ -0,0 +1,268 @@
+/*
+ * Copyright (C) 2026 agent <agent@local>
+ *
+ * This file is part of predator.
+ *
+ * predator is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * any later version.
+ *
+ * predator is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with predator.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "config.h"
+#include "microbench.hh"
+
+#include <cl/cl_msg.hh>
+#include <cl/stopwatch.hh>
+#include <cl/storage.hh>
+
+#include "glconf.hh"
+#include "symabstract.hh"
+#include "symcmp.hh"
+#include "symcut.hh"
+#include "symgc.hh"
+#include "symjoin.hh"
+#include "symstate.hh"
+#include "symtrace.hh"
+#include "symutil.hh"
+
+#include <algorithm>
+#include <cmath>
+#include <iomanip>
+#include <map>
+#include <random>
+#include <vector>
+
+/// count of heaps kept as a uniform sample of all the heaps captured
+#define MB_HEAPS_TOTAL                      0x100
+
+typedef std::pair<const CodeStorage::Block *, SymHeap *>    TSample;
+typedef std::map<const CodeStorage::Block *, SymHeapList>  TCorpus;
+
+static std::vector<TSample> reservoir;
+static unsigned long cntCaptured;
+static std::minstd_rand rng;
+static TCorpus corpus;
+
+void microBenchCapture(const SymHeap &sh, const CodeStorage::Block *bb)
+{
+    if (!GlConf::data.microBench)
+        return;
+
+    // reservoir sampling, each heap captured so far is kept equally likely
+    size_t idx = reservoir.size();
+    ++cntCaptured;
+    if (MB_HEAPS_TOTAL <= idx) {
+        std::uniform_int_distribution<unsigned long> pick(0, cntCaptured - 1);
+        idx = pick(rng);
+        if (MB_HEAPS_TOTAL <= idx)
+            return;
+
+        delete reservoir[idx].second;
+    }
+
+    SymHeap *dup = new SymHeap(sh);
+    Trace::waiveCloneOperation(*dup);
+
+    const TSample sample(bb, dup);
+    if (idx < reservoir.size())
+        reservoir[idx] = sample;
+    else
+        reservoir.push_back(sample);
+}
+
+/// a single run of the operation over a group of heaps captured in one block
+typedef void (*TBenchFnc)(SymHeapList &work, unsigned *pOps);
+
+static void benchCopy(SymHeapList &work, unsigned *pOps)
+{
+    for (const SymHeap *sh : work) {
+        // a copy is always written to, which is what makes copy-on-write pay
+        SymHeap copy(*sh);
+        copy.valCreate(VT_UNKNOWN, VO_UNKNOWN);
+        ++(*pOps);
+    }
+}
+
+static void benchAreEqual(SymHeapList &work, unsigned *pOps)
+{
+    const unsigned cnt = work.size();
+    for (unsigned i = 0; i < cnt; ++i) {
+        for (unsigned j = i + 1; j < cnt; ++j) {
+            areEqual(work[i], work[j]);
+            ++(*pOps);
+        }
+    }
+}
+
+static void benchJoinSymHeaps(SymHeapList &work, unsigned *pOps)
+{
+    const unsigned cnt = work.size();
+    for (unsigned i = 0; i < cnt; ++i) {
+        for (unsigned j = i + 1; j < cnt; ++j) {
+            EJoinStatus status;
+            SymHeap result(work[i].stor(),
+                    new Trace::TransientNode("benchJoinSymHeaps()"));
+            joinSymHeaps(&status, &result, work[i], work[j]);
+            ++(*pOps);
+        }
+    }
+}
+
+static void benchAbstractIfNeeded(SymHeapList &work, unsigned *pOps)
+{
+    for (SymHeap *sh : work) {
+        abstractIfNeeded(*sh);
+        ++(*pOps);
+    }
+}
+
+static void benchCollectJunk(SymHeapList &work, unsigned *pOps)
+{
+    for (SymHeap *sh : work) {
+        TObjList objs;
+        sh->gatherObjects(objs);
+        for (const TObjId obj : objs) {
+            if (!sh->isValid(obj))
+                // already collected as junk reachable from another object
+                continue;
+
+            collectJunk(*sh, obj);
+            ++(*pOps);
+        }
+    }
+}
+
+static void benchSplitJoinByCVars(SymHeapList &work, unsigned *pOps)
+{
+    for (SymHeap *sh : work) {
+        // cut off the frame of the second half of the program variables
+        TCVarList cut;
+        gatherProgramVars(cut, *sh);
+        cut.resize(cut.size() / 2);
+
+        SymHeap frame(sh->stor(),
+                new Trace::TransientNode("benchSplitJoinByCVars()"));
+        splitHeapByCVars(sh, cut, &frame);
+        joinHeapsByCVars(sh, &frame);
+        ++(*pOps);
+    }
+}
+
+static void benchValReplace(SymHeapList &work, unsigned *pOps)
+{
+    for (SymHeap *sh : work) {
+        TObjList objs;
+        sh->gatherObjects(objs);
+        for (const TObjId obj : objs) {
+            FldList fields;
+            sh->gatherLiveFields(fields, obj);
+            for (const FldHandle &fld : fields) {
+                const TValId val = fld.value();
+                if (val <= 0 || VT_UNKNOWN != sh->valTarget(val))
+                    continue;
+
+                // replace the unknown value by a fresh one
+                const TValId fresh = sh->valCreate(VT_UNKNOWN, VO_UNKNOWN);
+                sh->valReplace(val, fresh);
+                ++(*pOps);
+            }
+        }
+    }
+}
+
+/// return the time spent by a single run of fnc over the whole corpus
+static float runOnce(TBenchFnc fnc, unsigned *pOps)
+{
+    float total = 0.0;
+    *pOps = 0U;
+
+    for (const TCorpus::value_type &item : corpus) {
+        // prepare fresh copies of the heaps (not measured)
+        SymHeapList work(item.second);
+        Trace::waiveCloneOperation(work);
+
+        StopWatch watch;
+        fnc(work, pOps);
+        total += watch.elapsed();
+    }
+
+    return total;
+}
+
+static void runBench(const char *name, TBenchFnc fnc, const int runs)
+{
+    unsigned ops;
+
+    // warm up the caches and the allocator (not measured)
+    const int warmUp = std::max(1, runs / 5);
+    for (int i = 0; i < warmUp; ++i)
+        runOnce(fnc, &ops);
+
+    std::vector<float> samples;
+    for (int i = 0; i < runs; ++i)
+        samples.push_back(runOnce(fnc, &ops));
+
+    std::sort(samples.begin(), samples.end());
+    const float median = samples[runs / 2];
+
+    float sum = 0.0;
+    for (const float t : samples)
+        sum += t;
+    const float mean = sum / runs;
+
+    float sq = 0.0;
+    for (const float t : samples)
+        sq += (t - mean) * (t - mean);
+    const float sd = (1 < runs) ? std::sqrt(sq / (runs - 1)) : 0.0;
+
+    // print the times per run in milliseconds
+    CL_NOTE("micro_bench: " << std::left << std::setw(24) << name
+            << std::right << std::setw(8) << ops << " ops/run"
+            << std::fixed << std::setprecision(3)
+            << ", min " << (1e3 * samples.front()) << " ms"
+            << ", median " << (1e3 * median) << " ms"
+            << ", mean " << (1e3 * mean) << " ms"
+            << ", sd " << (1e3 * sd) << " ms");
+}
+
+void microBenchRun()
+{
+    const int runs = GlConf::data.microBench;
+    if (!runs)
+        return;
+
+    // group the sampled heaps by basic blocks to join/compare them together
+    for (const TSample &sample : reservoir) {
+        corpus[sample.first].insert(*sample.second);
+        delete sample.second;
+    }
+
+    CL_NOTE("micro_bench: " << reservoir.size() << " heaps sampled out of "
+            << cntCaptured << " captured, in " << corpus.size()
+            << " basic blocks, " << runs << " runs each");
+
+    if (!corpus.empty()) {
+        runBench("SymHeap::SymHeap()+write",benchCopy,              runs);
+        runBench("areEqual()",              benchAreEqual,          runs);
+        runBench("joinSymHeaps()",          benchJoinSymHeaps,      runs);
+        runBench("abstractIfNeeded()",      benchAbstractIfNeeded,  runs);
+        runBench("collectJunk()",           benchCollectJunk,       runs);
+        runBench("split/joinHeapsByCVars()",benchSplitJoinByCVars,  runs);
+        runBench("valReplace()",            benchValReplace,        runs);
+    }
+
+    // release the captured heaps before the trace graph is destroyed
+    corpus.clear();
+    reservoir.clear();
+    cntCaptured = 0UL;
+    rng.seed();
+}
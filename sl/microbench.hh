@@ -0,0 +1,41 @@
+/*
+ * Copyright (C) 2026 agent <agent@local>
+ *
+ * This file is part of predator.
+ *
+ * predator is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * any later version.
+ *
+ * predator is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with predator.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef H_GUARD_MICROBENCH_H
+#define H_GUARD_MICROBENCH_H
+
+/**
+ * @file microbench.hh
+ * microbenchmark of the heap operations that dominate the run time of the
+ * analysis, operating on heaps captured during a real analysis
+ */
+
+class SymHeap;
+
+namespace CodeStorage {
+    class Block;
+}
+
+/// capture the heap being inserted into the state of bb (if enabled)
+void microBenchCapture(const SymHeap &sh, const CodeStorage::Block *bb);
+
+/// time the operations on the captured heaps, print results, drop the heaps
+void microBenchRun();
+
+#endif /* H_GUARD_MICROBENCH_H */
@@ -0,0 +1,67 @@
+/*
+ * Copyright (C) 2026 agent <agent@local>
+ *
+ * This file is part of predator.
+ *
+ * predator is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * any later version.
+ *
+ * predator is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with predator.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "config.h"
+#include "perfstats.hh"
+
+#include <cl/cl_msg.hh>
+#include <cl/memdebug.hh>
+
+#include <fstream>
+
+unsigned long perfCounters[PC_TOTAL];
+
+static const char *perfCounterNames[PC_TOTAL] = {
+    "blocks_executed",
+    "heaps_executed",
+    "state_inserts",
+    "are_equal",
+    "join_symheaps",
+    "call_cache_hits",
+    "call_cache_misses",
+    "ent_allocs",
+    "ent_mallocs"
+};
+
+void resetPerfStats()
+{
+    for (int i = 0; i < PC_TOTAL; ++i)
+        perfCounters[i] = 0UL;
+}
+
+bool writePerfStats(const std::string &fileName, const float cpuTime)
+{
+    std::ofstream str(fileName.c_str());
+    if (!str) {
+        CL_ERROR("unable to write performance statistics: " << fileName);
+        return false;
+    }
+
+    str << "{ \"cpu_time\": " << cpuTime;
+
+    ssize_t peak;
+    if (peakMemUsage(&peak))
+        str << ", \"peak_mem\": " << peak;
+
+    for (int i = 0; i < PC_TOTAL; ++i)
+        str << ", \"" << perfCounterNames[i] << "\": " << perfCounters[i];
+
+    str << " }\n";
+    return !!str;
+}
@@ -0,0 +1,57 @@
+/*
+ * Copyright (C) 2026 agent <agent@local>
+ *
+ * This file is part of predator.
+ *
+ * predator is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * any later version.
+ *
+ * predator is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with predator.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef H_GUARD_PERFSTATS_H
+#define H_GUARD_PERFSTATS_H
+
+/**
+ * @file perfstats.hh
+ * counters of the operations that dominate the run time of the analysis, they
+ * are written by the perf_stats option for the perf-bench.sh benchmark
+ */
+
+#include <string>
+
+enum EPerfCounter {
+    PC_BLOCKS_EXECUTED = 0,     ///< count of SymExecEngine::execBlock() calls
+    PC_HEAPS_EXECUTED,          ///< count of heaps taken from block states
+    PC_STATE_INSERTS,           ///< count of SymStateMap::insert() calls
+    PC_ARE_EQUAL,               ///< count of areEqual() calls on SymHeap
+    PC_JOIN_SYMHEAPS,           ///< count of joinSymHeaps() calls
+    PC_CALL_CACHE_HITS,         ///< count of calls optimized out by call cache
+    PC_CALL_CACHE_MISSES,       ///< count of calls that needed execution
+    PC_ENT_ALLOCS,              ///< count of heap entities allocated
+    PC_ENT_MALLOCS,             ///< count of those that reached operator new
+    PC_TOTAL
+};
+
+extern unsigned long perfCounters[PC_TOTAL];
+
+inline void perfCount(const EPerfCounter cnt)
+{
+    ++perfCounters[cnt];
+}
+
+/// reset all the counters, so that a run does not inherit the previous ones
+void resetPerfStats();
+
+/// write a single JSON object with all the counters and resource usage
+bool writePerfStats(const std::string &fileName, float cpuTime);
+
+#endif /* H_GUARD_PERFSTATS_H */
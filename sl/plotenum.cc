@@ -22,7 +22,7 @@
 
 #include <cl/cl_msg.hh>
 
-#include <iomanip>
+#include <cstdio>
 
 // /////////////////////////////////////////////////////////////////////////////
 // implementation of PlotEnumerator
@@ -30,6 +30,8 @@ PlotEnumerator *PlotEnumerator::inst_ = 0;
 
 std::string PlotEnumerator::decorate(std::string name)
 {
+    name = this->withNamespace(name);
+
     // obtain a unique ID for the given name
     const int id = map_[name] ++;
 #if SYMPLOT_STOP_AFTER_N_STATES
@@ -40,16 +42,12 @@ std::string PlotEnumerator::decorate(std::string name)
     }
 #endif
 
-    // convert the ID to string
-    std::ostringstream str;
-    str << std::fixed
-        << std::setfill('0')
-        << std::setw(/* width of the ID suffix */ 4)
-        << id;
+    // convert the ID to string (4 is the minimal width of the ID suffix)
+    char suffix[/* "-" */ 1 + /* INT_MAX */ 10 + /* NUL */ 1];
+    snprintf(suffix, sizeof suffix, "-%04d", id);
 
     // merge name with ID
-    name += "-";
-    name += str.str();
+    name += suffix;
 
 #ifdef SYMPLOT_STOP_CONDITION
     if (SYMPLOT_STOP_CONDITION(name))
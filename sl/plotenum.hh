@@ -27,9 +27,9 @@
  */
 
 #include <string>
-#include <map>
+#include <unordered_map>
 
-// singleton
+// singleton, there is one instance per analysis (not meant to be thread-safe)
 class PlotEnumerator {
     public:
         static PlotEnumerator* instance() {
@@ -41,14 +41,27 @@ class PlotEnumerator {
         // generate kind of more unique name
         std::string decorate(std::string name);
 
+        /// prefix all names decorated from now on (counters are kept per ns)
+        void setNamespace(const std::string &ns) {
+            ns_ = ns;
+        }
+
+        /// prefix the given name by the namespace (if any) and a delimiter
+        std::string withNamespace(const std::string &name) const {
+            return (ns_.empty())
+                ? name
+                : (ns_ + "-" + name);
+        }
+
     private:
         static PlotEnumerator *inst_;
         PlotEnumerator() { }
         // FIXME: should we care about the destruction?
 
     private:
-        typedef std::map<std::string, int> TMap;
+        typedef std::unordered_map<std::string, int> TMap;
         TMap map_;
+        std::string ns_;
 };
 
 #endif /* H_GUARD_PLOT_ENUM_H */
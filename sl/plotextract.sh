@@ -0,0 +1,55 @@
+#!/bin/bash
+export SELF="$0"
+
+die() {
+    printf "%s: %s\n" "$SELF" "$*" >&2
+    exit 1
+}
+
+usage() {
+    printf "Usage: %s [-l] ARCHIVE [NAME.dot [...]]\n\n\
+Extract graphs written by Predator with the plot_archive option into separate\n\
+files in the current directory (all of them if no NAME is given).  With -l,\n\
+only list names of the graphs contained in ARCHIVE.\n" "$SELF" >&2
+    exit 1
+}
+
+list=no
+if test "-l" = "$1"; then
+    list=yes
+    shift
+fi
+
+archive="$1"
+test -r "$archive" || usage
+shift
+
+case "$archive" in
+    *.gz)
+        cat="gzip -dc" ;;
+    *)
+        cat="cat" ;;
+esac
+
+$cat "$archive" | awk -v list="$list" -v names="$*" '
+BEGIN {
+    cnt = split(names, tmp, " ")
+    for (i = 1; i <= cnt; i++)
+        wanted[tmp[i]] = 1
+}
+
+/^# plot: / {
+    if (out)
+        close(out)
+
+    out = ""
+    name = substr($0, 9)
+    if ("yes" == list)
+        print name
+    else if (!cnt || (name in wanted))
+        out = name
+    next
+}
+
+out { print > out }
+' || die "failed to read $archive"
@@ -0,0 +1,183 @@
+/*
+ * Copyright (C) 2026 agent <agent@local>
+ *
+ * This file is part of predator.
+ *
+ * predator is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * any later version.
+ *
+ * predator is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with predator.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "config.h"
+#include "plotsink.hh"
+
+#include <cl/cl_msg.hh>
+
+#include "glconf.hh"
+
+#include <cstdio>
+
+namespace PlotSink {
+
+/// size of the buffer that batches the writes into the plot archive
+static const size_t archiveBufSize = 1 << 20;
+
+struct Archive {
+    std::string         name;
+    FILE               *file;
+    char               *buf;
+    bool                isPipe;
+    bool                failed;
+
+    Archive():
+        file(0),
+        buf(0),
+        isPipe(false),
+        failed(false)
+    {
+    }
+};
+
+static Archive archive;
+
+static bool hasSuffix(const std::string &str, const std::string &suffix)
+{
+    return (suffix.size() <= str.size())
+        && !str.compare(str.size() - suffix.size(), suffix.size(), suffix);
+}
+
+static std::string shellQuote(const std::string &str)
+{
+    std::string quoted("'");
+    for (const char c : str) {
+        if ('\'' == c)
+            quoted += "'\\''";
+        else
+            quoted += c;
+    }
+
+    quoted += "'";
+    return quoted;
+}
+
+/// return the opened plot archive, or NULL if plots go to separate files
+static FILE* openArchive()
+{
+    if (archive.file)
+        return archive.file;
+
+    const std::string &name = GlConf::data.plotArchive;
+    if (name.empty() || archive.failed)
+        return 0;
+
+    if (hasSuffix(name, ".gz")) {
+        // let gzip(1) compress the archive in parallel with the analysis
+        const std::string cmd = "gzip -c > " + shellQuote(name);
+        archive.file = popen(cmd.c_str(), "w");
+        archive.isPipe = true;
+    }
+    else
+        archive.file = fopen(name.c_str(), "w");
+
+    if (!archive.file) {
+        CL_ERROR("unable to create plot archive '" << name
+                << "', writing separate files instead");
+        archive.failed = true;
+        return 0;
+    }
+
+    // batch the writes, the graphs are usually small
+    archive.buf = new char[archiveBufSize];
+    setvbuf(archive.file, archive.buf, _IOFBF, archiveBufSize);
+
+    archive.name = name;
+    CL_DEBUG("writing graphs into plot archive '" << name << "'...");
+    return archive.file;
+}
+
+static bool append(const std::string &fileName, const std::string &data)
+{
+    FILE *file = archive.file;
+    CL_BREAK_IF(!file);
+
+    // the marker is a comment for dot(1), so the archive as a whole is still
+    // a valid (multi-graph) dot file
+    fprintf(file, "# plot: %s\n", fileName.c_str());
+    fwrite(data.data(), 1, data.size(), file);
+    return !ferror(file);
+}
+
+void close()
+{
+    if (!archive.file)
+        return;
+
+    const int rv = (archive.isPipe)
+        ? pclose(archive.file)
+        : fclose(archive.file);
+
+    if (rv)
+        CL_ERROR("error while writing plot archive '" << archive.name << "'");
+
+    delete[] archive.buf;
+
+    // the next run (if any) opens the archive it is configured to use
+    archive = Archive();
+}
+
+} // namespace PlotSink
+
+// /////////////////////////////////////////////////////////////////////////////
+// implementation of PlotStream
+PlotStream::PlotStream(const std::string &plotName):
+    fileName_(plotName + ".dot"),
+    dest_(fileName_),
+    str_(&file_),
+    toArchive_(!!PlotSink::openArchive()),
+    ok_(true),
+    done_(false)
+{
+    if (toArchive_) {
+        // the graph is buffered and appended to the archive as a whole
+        dest_ = PlotSink::archive.name + ":" + fileName_;
+        str_ = &buf_;
+        return;
+    }
+
+    // create a dot file
+    file_.open(fileName_.c_str(), std::ios::out);
+    ok_ = !!file_;
+}
+
+PlotStream::~PlotStream()
+{
+    this->commit();
+}
+
+bool PlotStream::commit()
+{
+    if (done_)
+        return ok_;
+
+    done_ = true;
+    if (!ok_)
+        return false;
+
+    if (toArchive_) {
+        ok_ = !!buf_ && PlotSink::append(fileName_, buf_.str());
+        return ok_;
+    }
+
+    ok_ = !!file_;
+    file_.close();
+    return ok_;
+}
@@ -0,0 +1,76 @@
+/*
+ * Copyright (C) 2026 agent <agent@local>
+ *
+ * This file is part of predator.
+ *
+ * predator is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * any later version.
+ *
+ * predator is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with predator.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef H_GUARD_PLOT_SINK_H
+#define H_GUARD_PLOT_SINK_H
+
+/**
+ * @file plotsink.hh
+ * PlotStream - a single graph written either to a separate .dot file, or into
+ * the plot archive (if enabled by the @b plot_archive option)
+ */
+
+#include <fstream>
+#include <sstream>
+#include <string>
+
+class PlotStream {
+    public:
+        /// start writing a graph that would otherwise go to "plotName.dot"
+        PlotStream(const std::string &plotName);
+
+        /// commit() is called implicitly unless it has been called already
+        ~PlotStream();
+
+        /// false if the graph cannot be written (the file creation failed)
+        bool ok() const { return ok_; }
+
+        /// the stream to write the graph to
+        std::ostream& out() { return *str_; }
+
+        /// file name of the graph (prefixed by the name of the archive if used)
+        const std::string& dest() const { return dest_; }
+
+        /// finish the graph (append it to the archive if used)
+        bool commit();
+
+    private:
+        // copying NOT allowed
+        PlotStream(const PlotStream &);
+        PlotStream& operator=(const PlotStream &);
+
+    private:
+        std::string             fileName_;
+        std::string             dest_;
+        std::fstream            file_;
+        std::ostringstream      buf_;
+        std::ostream           *str_;
+        bool                    toArchive_;
+        bool                    ok_;
+        bool                    done_;
+};
+
+namespace PlotSink {
+
+/// flush and close the plot archive if it has been opened
+void close();
+
+} // namespace PlotSink
+
+#endif /* H_GUARD_PLOT_SINK_H */
@@ -0,0 +1,322 @@
+/*
+ * Copyright (C) 2026 agent <agent@local>
+ *
+ * This file is part of predator.
+ *
+ * predator is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * any later version.
+ *
+ * predator is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with predator.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "config.h"
+#include "portfolio.hh"
+
+#include <cl/cl_msg.hh>
+#include <cl/code_listener.h>
+
+#include "budget.hh"
+#include "glconf.hh"
+
+#include <algorithm>
+#include <cerrno>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <string>
+#include <vector>
+
+#include <boost/algorithm/string.hpp>
+
+#include <signal.h>
+#include <sys/types.h>
+#include <sys/wait.h>
+#include <unistd.h>
+
+#ifdef __linux__
+#   include <sys/prctl.h>
+#endif
+
+/// exit codes of the processes running the particular variants
+enum EVerdict {
+    PV_NO_ERRORS = 0x40,    ///< the analysis has completed, no errors reported
+    PV_ERRORS,              ///< the analysis has reported some errors
+    PV_UNKNOWN              ///< the analysis has failed, no errors reported
+};
+
+/// how long to sleep between checks of the running variants (in microseconds)
+#define PORTFOLIO_POLL_USEC                 10000
+
+// messages captured by a child process, each of them stored as its kind, its
+// length, ':' and the message itself (which may span multiple lines)
+static FILE *capFile;
+
+static void capMsg(const char kind, const char *msg)
+{
+    fprintf(capFile, "%c%zu:%s\n", kind, strlen(msg), msg);
+}
+
+static void capDebug(const char *msg)
+{
+    // debug messages are not subject of the portfolio, print them right away
+    fprintf(stderr, "%s\n", msg);
+}
+
+static void capWarn(const char *msg)
+{
+    capMsg('W', msg);
+}
+
+static void capError(const char *msg)
+{
+    capMsg('E', msg);
+}
+
+static void capNote(const char *msg)
+{
+    capMsg('N', msg);
+}
+
+static void capDie(const char *msg)
+{
+    capMsg('E', msg);
+    fflush(capFile);
+    _exit(PV_UNKNOWN);
+}
+
+static void appendOpts(std::string *pConf, const std::string &opts)
+{
+    if (opts.empty())
+        return;
+
+    if (!pConf->empty())
+        *pConf += ",";
+
+    *pConf += opts;
+}
+
+bool extractPortfolio(std::string *pConf, std::string *pVariants)
+{
+    return GlConf::extractOption(pConf, "portfolio", pVariants);
+}
+
+static void runVariant(
+        const CodeStorage::Storage     &stor,
+        const std::string              &conf,
+        TAnalysisRunner                 runner,
+        FILE                           *file)
+{
+#ifdef __linux__
+    // do not outlive the parent process (e.g. if killed on timeout)
+    prctl(PR_SET_PDEATHSIG, SIGKILL);
+#endif
+
+    // capture all messages
+    capFile = file;
+    struct cl_init_data data = {
+        capDebug,           // .debug
+        capWarn,            // .warn
+        capError,           // .error
+        capNote,            // .note
+        capDie,             // .die
+        cl_debug_level()    // .debug_level
+    };
+    cl_global_init(&data);
+
+    bool ok = false;
+    try {
+        ok = runner(stor, conf);
+    }
+    catch (...) {
+        CL_DEBUG("portfolio: the analysis has thrown an exception");
+    }
+
+    // do not run any destructors/atexit handlers of the parent process
+    fflush(capFile);
+
+    // only errors in the analysed program count, not internal ones (e.g. I/O)
+    if (AnalysisBudget::anyErrorReported())
+        _exit(PV_ERRORS);
+
+    _exit((ok) ? PV_NO_ERRORS : PV_UNKNOWN);
+}
+
+static void emitCaptured(FILE *file)
+{
+    rewind(file);
+
+    char kind;
+    size_t len;
+    while (2 == fscanf(file, "%c%zu:", &kind, &len)) {
+        std::string msg(len, '\0');
+        if (len && len != fread(&msg[0], 1, len, file))
+            break;
+
+        // skip the trailing new-line
+        fgetc(file);
+
+        switch (kind) {
+            case 'E':
+                cl_error(msg.c_str());
+                break;
+
+            case 'W':
+                cl_warn(msg.c_str());
+                break;
+
+            default:
+                cl_note(msg.c_str());
+        }
+    }
+}
+
+/// wait for any of the given processes to end, 0 is stored for those not running
+static int /* idx */ waitForVariant(int *pStatus, std::vector<pid_t> &pids)
+{
+    // do not use waitpid(-1, ...), which could reap unrelated child processes
+    for (;;) {
+        for (unsigned idx = 0; idx < pids.size(); ++idx) {
+            const pid_t pid = pids[idx];
+            if (!pid)
+                continue;
+
+            const pid_t rv = waitpid(pid, pStatus, WNOHANG);
+            if (!rv)
+                // still running
+                continue;
+
+            if (rv < 0) {
+                if (EINTR == errno)
+                    continue;
+
+                CL_WARN("portfolio: waitpid() failed: " << strerror(errno));
+                *pStatus = 0;
+            }
+
+            pids[idx] = 0;
+            return idx;
+        }
+
+        usleep(PORTFOLIO_POLL_USEC);
+    }
+}
+
+bool runPortfolio(
+        const CodeStorage::Storage     &stor,
+        const std::string              &baseConf,
+        const std::string              &variants,
+        TAnalysisRunner                 runner)
+{
+    std::vector<std::string> list;
+    boost::split(list, variants, boost::algorithm::is_any_of("|"));
+
+    const unsigned cnt = list.size();
+    std::vector<pid_t> pids(cnt, /* not running */ 0);
+    std::vector<FILE *> files(cnt, /* not created */ 0);
+    unsigned cntRunning = 0U;
+
+    // do not let the children flush what the parent has buffered
+    fflush(0);
+
+    for (unsigned i = 0; i < cnt; ++i) {
+        std::string opts = list[i];
+        std::replace(opts.begin(), opts.end(), '+', ',');
+
+        std::string conf = baseConf;
+        appendOpts(&conf, opts);
+
+        files[i] = tmpfile();
+        if (!files[i]) {
+            CL_WARN("portfolio: unable to create a temporary file: "
+                    << strerror(errno));
+            continue;
+        }
+
+        const pid_t pid = fork();
+        if (pid < 0) {
+            CL_WARN("portfolio: fork() failed: " << strerror(errno));
+            fclose(files[i]);
+            files[i] = 0;
+            continue;
+        }
+
+        if (!pid)
+            // child process, this does not return
+            runVariant(stor, conf, runner, files[i]);
+
+        CL_DEBUG("portfolio: variant #" << i << " \"" << conf
+                << "\" runs as PID " << pid);
+
+        pids[i] = pid;
+        ++cntRunning;
+    }
+
+    if (!cntRunning) {
+        // no variant could be started, do at least what we were asked for
+        CL_WARN("portfolio: no variant has been started, "
+                "running the analysis in-process");
+
+        for (FILE *file : files)
+            if (file)
+                fclose(file);
+
+        return runner(stor, baseConf);
+    }
+
+    // wait for the first variant with a definite result
+    int winner = -1;
+    int fallback = -1;
+    while (cntRunning && winner < 0) {
+        int status;
+        const int idx = waitForVariant(&status, pids);
+        --cntRunning;
+
+        if (WIFEXITED(status)) {
+            const int code = WEXITSTATUS(status);
+            if (PV_NO_ERRORS == code || PV_ERRORS == code) {
+                winner = idx;
+                break;
+            }
+        }
+
+        CL_DEBUG("portfolio: variant #" << idx
+                << " has ended without a definite result");
+
+        if (fallback < 0)
+            fallback = idx;
+    }
+
+    // kill the variants that are still running
+    for (pid_t &pid : pids) {
+        if (!pid)
+            continue;
+
+        kill(pid, SIGKILL);
+        waitpid(pid, 0, 0);
+        pid = 0;
+    }
+
+    // emit messages of the winner (or at least of a variant that has ended)
+    const int chosen = (0 <= winner) ? winner : fallback;
+    if (0 <= chosen) {
+        CL_DEBUG("portfolio: emitting messages of variant #" << chosen);
+        emitCaptured(files[chosen]);
+    }
+
+    if (winner < 0)
+        CL_WARN("portfolio: no variant has reached a definite result");
+
+    for (FILE *file : files)
+        if (file)
+            fclose(file);
+
+    return (0 <= winner);
+}
@@ -0,0 +1,64 @@
+/*
+ * Copyright (C) 2026 agent <agent@local>
+ *
+ * This file is part of predator.
+ *
+ * predator is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * any later version.
+ *
+ * predator is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with predator.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef H_GUARD_PORTFOLIO_H
+#define H_GUARD_PORTFOLIO_H
+
+/**
+ * @file portfolio.hh
+ * run several configurations of the analysis concurrently, see runPortfolio()
+ */
+
+#include <string>
+
+namespace CodeStorage {
+    struct Storage;
+}
+
+/// run the analysis with the given config string, return false if it failed
+typedef bool (*TAnalysisRunner)(const CodeStorage::Storage &, const std::string &);
+
+/**
+ * remove the portfolio:<variants> option from the given config string
+ * @param pConf the config string to update
+ * @param pVariants where to store the value of the option
+ * @return true if the option has been found
+ */
+bool extractPortfolio(std::string *pConf, std::string *pVariants);
+
+/**
+ * fork one process per each variant of the configuration (they share the
+ * already built CodeStorage::Storage) and emit the messages of the first one
+ * that ends up with a definite result, i.e. without any error reported or with
+ * an error reported.  The remaining processes are killed at that point.
+ * @param stor the code storage to run the analysis on
+ * @param baseConf options shared by all the variants
+ * @param variants '|'-separated list of variants, each of them consisting of
+ * '+'-separated options that are appended to baseConf
+ * @param runner the function to run the analysis with
+ * @note if no variant can be started, runner is called in-process with baseConf
+ * @return true if a variant has reached a definite result
+ */
+bool runPortfolio(
+        const CodeStorage::Storage     &stor,
+        const std::string              &baseConf,
+        const std::string              &variants,
+        TAnalysisRunner                 runner);
+
+#endif /* H_GUARD_PORTFOLIO_H */
@@ -1408,7 +1408,8 @@ bool BuiltInTable::handleBuiltIn(
         hdl = it->second;
 
     SymHeap &sh = core.sh();
-    sh.traceUpdate(new Trace::InsnNode(sh.traceNode(), &insn, /* bin */ true));
+    if (Trace::isRecorded(Trace::TL_FULL))
+        sh.traceUpdate(new Trace::InsnNode(sh.traceNode(), &insn, /* bin */ true));
 
     return hdl(dst, core, insn, name);
 }
@@ -44,18 +44,37 @@ LOCAL_DEBUG_PLOTTER(symcall, DEBUG_SYMCALL)
 
 // /////////////////////////////////////////////////////////////////////////////
 // call context cache per one fnc
+/// return the key of the bucket where the given entry heap belongs
+inline size_t bucketOf(const SymHeap &sh)
+{
+#if 1 < SE_ENABLE_CALL_CACHE
+    // joinSymHeaps() can succeed even if the kinds of objects or the sets of
+    // local variables differ, only the gl variables are required to match
+    return hashOfGlVars(sh);
+#else
+    return hashOf(sh);
+#endif
+}
+
 class PerFncCache {
     private:
         typedef std::vector<SymCallCtx *> TCtxMap;
 
-        SymHeapUnion    huni_;
-        TCtxMap         ctxMap_;
+        /// call contexts whose entry heaps share the same key (see bucketOf())
+        struct Bucket {
+            SymHeapUnion    huni;
+            TCtxMap         ctxMap;
+        };
+
+        typedef std::map<size_t /* hash */, Bucket> TBuckets;
+
+        TBuckets        buckets_;
 #if !SE_ENABLE_CALL_CACHE
         SymCallCtx     *null_;
 #endif
         int             missCntSinceLastHit_;
 
-        int lookupCore(const SymHeap &sh);
+        int lookupCore(Bucket &bucket, const SymHeap &sh);
 
         void cacheHit() {
             if (0 < missCntSinceLastHit_)
@@ -71,19 +90,54 @@ class PerFncCache {
         }
 
         ~PerFncCache() {
-            for (SymCallCtx *ctx : ctxMap_) {
-                delete ctx;
-            }
+            for (const TBuckets::value_type &item : buckets_)
+                for (SymCallCtx *ctx : item.second.ctxMap)
+                    delete ctx;
         }
 
         int missCntSinceLastHit() const {
             return missCntSinceLastHit_;
         }
 
+        /// return count of the cached call contexts
+        int size() const {
+            int cnt = 0;
+            for (const TBuckets::value_type &item : buckets_)
+                cnt += item.second.ctxMap.size();
+
+            return cnt;
+        }
+
+        /// return count of the (non-empty) buckets
+        int cntBuckets() const {
+            return buckets_.size();
+        }
+
+        /// return count of call contexts in the largest bucket
+        int maxBucketSize() const {
+            int max = 0;
+            for (const TBuckets::value_type &item : buckets_)
+                max = std::max<int>(max, item.second.ctxMap.size());
+
+            return max;
+        }
+
+        /// append all cached call contexts to dst
+        void gatherCtxs(std::vector<const SymCallCtx *> &dst) const {
+            for (const TBuckets::value_type &item : buckets_)
+                for (const SymCallCtx *ctx : item.second.ctxMap)
+                    if (ctx)
+                        dst.push_back(ctx);
+        }
+
+        /// remove the given call ctx (which must not be in use) from the cache
+        void evict(const SymCallCtx *ctx);
+
         bool inUse() const {
-            for (const SymCallCtx *ctx : ctxMap_)
-                if (ctx->inUse())
-                    return true;
+            for (const TBuckets::value_type &item : buckets_)
+                for (const SymCallCtx *ctx : item.second.ctxMap)
+                    if (ctx->inUse())
+                        return true;
 
             return false;
         }
@@ -93,11 +147,29 @@ class PerFncCache {
             return;
 #endif
             const int missCnt = 1 + missCntSinceLastHit_;
-            const int idx = this->lookupCore(of);
-            CL_BREAK_IF(!areEqual(of, huni_[idx]));
+            const TBuckets::iterator itSrc = buckets_.find(bucketOf(of));
+            CL_BREAK_IF(buckets_.end() == itSrc);
+            Bucket &src = itSrc->second;
+            const int idx = this->lookupCore(src, of);
+            CL_BREAK_IF(!areEqual(of, src.huni[idx]));
 
             Trace::waiveCloneOperation(by);
-            huni_.swapExisting(idx, by);
+            const size_t hash = bucketOf(by);
+            if (hash == itSrc->first)
+                src.huni.swapExisting(idx, by);
+            else {
+                // the entry heap does not belong to this bucket any more
+                SymCallCtx *ctx = src.ctxMap[idx];
+                src.ctxMap.erase(src.ctxMap.begin() + idx);
+                src.huni.eraseExisting(idx);
+                if (src.ctxMap.empty())
+                    buckets_.erase(itSrc);
+
+                Bucket &dst = buckets_[hash];
+                dst.huni.insertNew(by);
+                dst.ctxMap.push_back(ctx);
+            }
+
             missCntSinceLastHit_ = missCnt;
         }
 
@@ -107,7 +179,9 @@ class PerFncCache {
          */
         SymCallCtx*& lookup(const SymHeap &sh) {
 #if SE_ENABLE_CALL_CACHE
-            return ctxMap_[this->lookupCore(sh)];
+            // only the heaps in the same bucket can cover the given one
+            Bucket &bucket = buckets_[bucketOf(sh)];
+            return bucket.ctxMap[this->lookupCore(bucket, sh)];
 #else
             (void) sh;
             return null_ = 0;
@@ -115,8 +189,35 @@ class PerFncCache {
         }
 };
 
-int PerFncCache::lookupCore(const SymHeap &sh)
+void PerFncCache::evict(const SymCallCtx *ctx)
 {
+    CL_BREAK_IF(ctx->inUse());
+
+    for (TBuckets::iterator it = buckets_.begin(); it != buckets_.end(); ++it) {
+        Bucket &bucket = it->second;
+        TCtxMap &ctxMap = bucket.ctxMap;
+        const TCtxMap::iterator itCtx =
+            std::find(ctxMap.begin(), ctxMap.end(), ctx);
+        if (ctxMap.end() == itCtx)
+            continue;
+
+        delete ctx;
+        bucket.huni.eraseExisting(itCtx - ctxMap.begin());
+        ctxMap.erase(itCtx);
+        if (ctxMap.empty())
+            buckets_.erase(it);
+
+        return;
+    }
+
+    CL_BREAK_IF("PerFncCache::evict() got a ctx not found in the cache");
+}
+
+int PerFncCache::lookupCore(Bucket &bucket, const SymHeap &sh)
+{
+    SymHeapUnion &huni = bucket.huni;
+    TCtxMap &ctxMap = bucket.ctxMap;
+
 #if 1 < SE_ENABLE_CALL_CACHE
     if (GlConf::data.stateLiveOrdering)
         CL_DIE("SE_STATE_ON_THE_FLY_ORDERING"
@@ -124,12 +225,12 @@ int PerFncCache::lookupCore(const SymHeap &sh)
 
     EJoinStatus     status;
     SymHeap         result(sh.stor(), new Trace::TransientNode("PerFncCache"));
-    const int       cnt = huni_.size();
+    const int       cnt = huni.size();
     int             idx;
 
     // try join
     for(idx = 0; idx < cnt; ++idx) {
-        const SymHeap &shIn = huni_[idx];
+        const SymHeap &shIn = huni[idx];
         if (!joinSymHeaps(&status, &result, shIn, sh))
             // join failed with this heap, try the next one
             continue;
@@ -147,7 +248,7 @@ int PerFncCache::lookupCore(const SymHeap &sh)
                 break;
         }
 
-        SymCallCtx *&ctx = ctxMap_[idx];
+        SymCallCtx *&ctx = ctxMap[idx];
         if (ctx->inUse())
             // context in use by the current backtrace, keep going...
             continue;
@@ -156,14 +257,15 @@ int PerFncCache::lookupCore(const SymHeap &sh)
         delete ctx;
         ctx = 0;
 
-        // update the cache entry
+        // update the cache entry (the join preserves gl variables, so the
+        // updated entry stays in the same bucket)
         if (JS_THREE_WAY == status)
-            huni_.swapExisting(idx, result);
+            huni.swapExisting(idx, result);
         else {
             CL_BREAK_IF(JS_USE_SH2 != status);
             SymHeap shDup(sh);
             Trace::waiveCloneOperation(shDup);
-            huni_.swapExisting(idx, shDup);
+            huni.swapExisting(idx, shDup);
         }
 
         this->cacheHit();
@@ -171,12 +273,12 @@ int PerFncCache::lookupCore(const SymHeap &sh)
     }
 
 #else // 1 == SE_ENABLE_CALL_CACHE means "graph isomorphism only"
-    int idx = huni_.lookup(sh);
+    int idx = huni.lookup(sh);
     if (-1 != idx) {
         this->cacheHit();
 
         if (1 < GlConf::data.stateLiveOrdering) {
-            rotate(ctxMap_.begin(), ctxMap_.begin() + idx, ctxMap_.end());
+            rotate(ctxMap.begin(), ctxMap.begin() + idx, ctxMap.end());
             idx = 0;
         }
 
@@ -185,10 +287,10 @@ int PerFncCache::lookupCore(const SymHeap &sh)
 #endif
 
     // cache miss
-    idx = ctxMap_.size();
-    huni_.insertNew(sh);
-    ctxMap_.push_back((SymCallCtx *) 0);
-    CL_BREAK_IF(huni_.size() != ctxMap_.size());
+    idx = ctxMap.size();
+    huni.insertNew(sh);
+    ctxMap.push_back((SymCallCtx *) 0);
+    CL_BREAK_IF(huni.size() != ctxMap.size());
 
     ++missCntSinceLastHit_;
     return idx;
@@ -203,16 +305,43 @@ struct SymCallCache::Private {
     typedef std::map<cl_uid_t, PerFncCache>             TCache;
     typedef std::vector<SymCallCtx *>                   TCtxStack;
 
+    /// statistics of the call cache per one fnc
+    struct FncStats {
+        unsigned                hits;
+        unsigned                misses;
+        unsigned                evictions;
+        size_t                  bytes;
+
+        FncStats():
+            hits(0),
+            misses(0),
+            evictions(0),
+            bytes(0)
+        {
+        }
+    };
+
+    typedef std::map<cl_uid_t, FncStats>                TStats;
+
     TCache                      cache;
+    TStats                      stats;
     TCtxStack                   ctxStack;
     SymBackTrace                bt;
+    unsigned long               tick;
+    size_t                      totalBytes;
 
     void importGlVar(SymHeap &sh, const CVar &cv);
     void resolveHeapCut(TCVarList &cut, SymHeap &sh, TFncRef fnc);
     SymCallCtx* getCallCtx(const SymHeap &entry, TFncRef fnc);
+    void recountBytes(cl_uid_t uid);
+    void chargeCtx(SymCallCtx *ctx);
+    void dropFncCache(TCache::iterator it);
+    void evictToFitBudget();
 
     Private(TStorRef stor):
-        bt(stor)
+        bt(stor),
+        tick(0),
+        totalBytes(0)
     {
     }
 };
@@ -229,6 +358,8 @@ struct SymCallCtx::Private {
     int                         nestLevel;
     bool                        computed;
     bool                        flushed;
+    unsigned long               lastUse;
+    size_t                      bytes;
 
     void assignReturnValue(SymHeap &sh);
     void destroyStackFrame(SymHeap &sh);
@@ -242,7 +373,9 @@ struct SymCallCtx::Private {
         callFrame(cd_->bt.stor(),
                 new Trace::TransientNode("SymCallCtx::Private::callFrame")),
         computed(false),
-        flushed(false)
+        flushed(false),
+        lastUse(0),
+        bytes(0)
     {
     }
 };
@@ -471,7 +604,8 @@ void SymCallCtx::flushCallResults(SymState &dst)
 void SymCallCtx::invalidate()
 {
     typedef SymCallCache::Private::TCache TCache;
-    TCache &cache = d->cd->cache;
+    SymCallCache::Private *const cd = d->cd;
+    TCache &cache = cd->cache;
     const CodeStorage::Fnc &fnc = *d->fnc;
     const cl_uid_t uid = uidOf(fnc);
     const TCache::iterator it = cache.find(uid);
@@ -480,23 +614,28 @@ void SymCallCtx::invalidate()
         return;
     }
 
+    if (d->flushed)
+        // the results are cached now, charge them against the budget
+        cd->chargeCtx(this);
+
 #if SE_CALL_CACHE_MISS_THR
     const PerFncCache &pfc = it->second;
     const int missCnt = pfc.missCntSinceLastHit();
-    if (missCnt < (SE_CALL_CACHE_MISS_THR))
-        return;
-
-    const struct cl_loc *loc = locationOf(fnc);
-    CL_DEBUG_MSG(&loc, "SE_CALL_CACHE_MISS_THR reached for "
-            << nameOf(fnc) << "(): " << missCnt);
-
-    if (pfc.inUse()) {
-        CL_DEBUG_MSG(&loc, "... but PerFncCache is still being used!");
-        return;
+    if ((SE_CALL_CACHE_MISS_THR) <= missCnt) {
+        const struct cl_loc *loc = locationOf(fnc);
+        CL_DEBUG_MSG(&loc, "SE_CALL_CACHE_MISS_THR reached for "
+                << nameOf(fnc) << "(): " << missCnt);
+
+        if (pfc.inUse())
+            CL_DEBUG_MSG(&loc, "... but PerFncCache is still being used!");
+        else
+            // NOTE: this destroys the SymCallCtx object itself
+            cd->dropFncCache(it);
     }
-
-    cache.erase(it);
 #endif
+
+    // the SymCallCtx object may have been destroyed by now
+    cd->evictToFitBudget();
 }
 
 // /////////////////////////////////////////////////////////////////////////////
@@ -728,7 +867,9 @@ SymCallCtx* SymCallCache::Private::getCallCtx(const SymHeap &entry, TFncRef fnc)
         ctx = new SymCallCtx(this);
         ctx->d->fnc     = &fnc;
         ctx->d->entry   = entry;
+        ctx->d->lastUse = ++this->tick;
         Trace::waiveCloneOperation(ctx->d->entry);
+        ++this->stats[uid].misses;
 
         // enter ctx stack
         this->ctxStack.push_back(ctx);
@@ -751,6 +892,9 @@ SymCallCtx* SymCallCache::Private::getCallCtx(const SymHeap &entry, TFncRef fnc)
         return 0;
     }
 
+    ctx->d->lastUse = ++this->tick;
+    ++this->stats[uid].hits;
+
     // enter ctx stack
     this->ctxStack.push_back(ctx);
 
@@ -758,6 +902,129 @@ SymCallCtx* SymCallCache::Private::getCallCtx(const SymHeap &entry, TFncRef fnc)
     return ctx;
 }
 
+/// estimate count of bytes occupied by the heaps a call ctx keeps in cache
+size_t estimateBytes(const SymHeap &entry, const SymState &results)
+{
+    size_t cntEnts = entry.cntValidIds();
+    for (const SymHeap *sh : results)
+        cntEnts += sh->cntValidIds();
+
+    return (SE_CALL_CACHE_ENT_SIZE) * cntEnts;
+}
+
+void SymCallCache::Private::recountBytes(const cl_uid_t uid)
+{
+    size_t bytes = 0U;
+
+    const TCache::const_iterator it = this->cache.find(uid);
+    if (this->cache.end() != it) {
+        std::vector<const SymCallCtx *> ctxs;
+        it->second.gatherCtxs(ctxs);
+        for (const SymCallCtx *ctx : ctxs)
+            bytes += ctx->d->bytes;
+    }
+
+    // replace the previous estimation by the current one
+    size_t &fncBytes = this->stats[uid].bytes;
+    this->totalBytes -= fncBytes;
+    this->totalBytes += bytes;
+    fncBytes = bytes;
+}
+
+void SymCallCache::Private::chargeCtx(SymCallCtx *ctx)
+{
+    ctx->d->bytes = estimateBytes(ctx->d->entry, ctx->d->rawResults);
+    this->recountBytes(uidOf(*ctx->d->fnc));
+}
+
+void SymCallCache::Private::dropFncCache(TCache::iterator it)
+{
+    const cl_uid_t uid = it->first;
+    this->stats[uid].evictions += it->second.size();
+    this->cache.erase(it);
+    this->recountBytes(uid);
+}
+
+void SymCallCache::Private::evictToFitBudget()
+{
+    const size_t budget = 1024UL * GlConf::data.callCacheBudget;
+    if (!budget)
+        // unlimited
+        return;
+
+    while (budget < this->totalBytes) {
+        // look for the least recently used ctx that is not in use
+        PerFncCache *lruCache = 0;
+        const SymCallCtx *lruCtx = 0;
+        cl_uid_t lruUid = 0;
+
+        for (TCache::value_type &item : this->cache) {
+            PerFncCache &pfc = item.second;
+            std::vector<const SymCallCtx *> ctxs;
+            pfc.gatherCtxs(ctxs);
+            for (const SymCallCtx *ctx : ctxs) {
+                if (ctx->inUse())
+                    continue;
+
+                if (lruCtx && lruCtx->d->lastUse <= ctx->d->lastUse)
+                    continue;
+
+                lruCache = &pfc;
+                lruCtx = ctx;
+                lruUid = item.first;
+            }
+        }
+
+        if (!lruCtx) {
+            CL_DEBUG("SymCallCache exceeds its budget"
+                    ", but all cached contexts are still in use");
+            return;
+        }
+
+        lruCache->evict(lruCtx);
+        ++this->stats[lruUid].evictions;
+        this->recountBytes(lruUid);
+    }
+}
+
+void SymCallCache::printStats() const
+{
+    TStorRef stor = d->bt.stor();
+
+    unsigned cntCtx = 0U;
+    for (const Private::TCache::value_type &item : d->cache)
+        cntCtx += item.second.size();
+
+    CL_NOTE("... call cache: " << d->cache.size() << " function(s)"
+            ", " << cntCtx << " context(s)"
+            ", " << (d->totalBytes >> 10) << " KiB (estimated)");
+
+    for (const Private::TStats::value_type &item : d->stats) {
+        const cl_uid_t uid = item.first;
+        const Private::FncStats &st = item.second;
+
+        int cnt = 0, cntBuckets = 0, maxBucketSize = 0;
+        const Private::TCache::const_iterator it = d->cache.find(uid);
+        if (d->cache.end() != it) {
+            const PerFncCache &pfc = it->second;
+            cnt = pfc.size();
+            cntBuckets = pfc.cntBuckets();
+            maxBucketSize = pfc.maxBucketSize();
+        }
+
+        const CodeStorage::Fnc &fnc = *stor.fncs[uid];
+        CL_NOTE_MSG(locationOf(fnc),
+                "___ call cache of " << nameOf(fnc) << "()"
+                ", " << cnt << " context(s)"
+                " in " << cntBuckets << " bucket(s)"
+                " (" << maxBucketSize << " at most)"
+                ", " << st.hits << " hit(s)"
+                ", " << st.misses << " miss(es)"
+                ", " << st.evictions << " eviction(s)"
+                ", " << (st.bytes >> 10) << " KiB (estimated)");
+    }
+}
+
 SymCallCtx* SymCallCache::getCallCtx(
         SymHeap                         entry,
         const CodeStorage::Fnc          &fnc,
@@ -61,6 +61,9 @@ class SymCallCache {
                 const CodeStorage::Fnc       &fnc,
                 const CodeStorage::Insn      &insn);
 
+        /// print per-function statistics of the cache (hits, misses, ...)
+        void printStats() const;
+
     private:
         /// object copying is @b not allowed
         SymCallCache(const SymCallCache &);
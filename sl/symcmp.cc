@@ -22,6 +22,7 @@
 
 #include <cl/cl_msg.hh>
 
+#include "perfstats.hh"
 #include "symbt.hh"
 #include "symseg.hh"
 #include "symutil.hh"
@@ -340,6 +341,7 @@ bool areEqual(
         const SymHeap           &sh1,
         const SymHeap           &sh2)
 {
+    perfCount(PC_ARE_EQUAL);
     if (!areEqual(sh1.exitPoint(), sh2.exitPoint()))
         return false;
 
@@ -373,3 +375,39 @@ bool areEqual(
     return sh1.matchPreds(sh2, vMap[0])
         && sh2.matchPreds(sh1, vMap[1]);
 }
+
+/// mix the given value into the hash (same formula as boost::hash_combine())
+inline void hashCombine(size_t &hash, const size_t val)
+{
+    hash ^= val + 0x9e3779b9 + (hash << 6) + (hash >> 2);
+}
+
+size_t hashOf(const SymHeap &sh)
+{
+    size_t hash = 0U;
+
+    // areEqual() requires the live program variables to match
+    TCVarSet cVars;
+    gatherProgramVars(cVars, sh);
+    hashCombine(hash, cVars.size());
+    for (const CVar &cv : cVars) {
+        hashCombine(hash, cv.uid);
+        hashCombine(hash, cv.inst);
+    }
+
+    return hash;
+}
+
+size_t hashOfGlVars(const SymHeap &sh)
+{
+    size_t hash = 0U;
+
+    TCVarSet cVars;
+    gatherProgramVars(cVars, sh);
+    for (const CVar &cv : cVars) {
+        if (/* gl var */ !cv.inst)
+            hashCombine(hash, cv.uid);
+    }
+
+    return hash;
+}
@@ -37,6 +37,19 @@ bool areEqual(
         const SymHeap           &sh1,
         const SymHeap           &sh2);
 
+/**
+ * compute a hash of the live program variables of the given heap, which
+ * areEqual() requires to match, i.e. two heaps can be equal only if they have
+ * the same hash
+ */
+size_t hashOf(const SymHeap &sh);
+
+/**
+ * compute a hash of the gl variables of the given heap, which joinSymHeaps()
+ * requires to match (local variables can be recovered on join)
+ */
+size_t hashOfGlVars(const SymHeap &sh);
+
 inline bool checkNonPosValues(int a, int b)
 {
     if (0 < a && 0 < b)
@@ -426,8 +426,10 @@ void splitHeapByCVars(
         if (!hasKey(cset, cv))
             complement.insert(cv);
 
-    // compute the corresponding frame
-    prune(*srcDst, *saveFrameTo, complement);
+    // compute the corresponding frame, unless prune() has already enlarged
+    // the cut by all program variables, in which case the frame is empty
+    if (!complement.empty() || srcDst->objEstimatedType(OBJ_RETURN))
+        prune(*srcDst, *saveFrameTo, complement);
 
     // print some statistics
 #if DEBUG_SYMCUT || !defined NDEBUG
@@ -471,7 +473,64 @@ void joinHeapsByCVars(
     // gather _all_ program variables of *src2
     DeepCopyData::TCut cset;
     gatherProgramVars(cset, *src2);
-    
+    if (cset.empty() && !src2->objEstimatedType(OBJ_RETURN))
+        // nothing to merge
+        return;
+
     // forward-only merge of *src2 into *srcDst
     prune(*src2, *srcDst, cset, /* optimization */ true);
 }
+
+void compactHeapIds(SymHeap *sh)
+{
+    const unsigned lastIdOrig = sh->lastId();
+
+    // gather _all_ program variables of *sh
+    DeepCopyData::TCut cset;
+    gatherProgramVars(cset, *sh);
+
+    Trace::Node *trNode = new Trace::CompactIdsNode(sh->traceNode());
+    SymHeap dst(sh->stor(), trNode);
+    DeepCopyData dc(*sh, dst, cset, /* digBackward */ true);
+
+    // go through all program variables
+    Trace::TIdMapper &idMapper = trNode->idMapper();
+    const DeepCopyData::TCut snap(cset);
+    for (CVar cv : snap) {
+        const TObjId srcReg = sh->regionByVar(cv, /* createIfNeeded */ false);
+        const TObjId dstReg = dst.regionByVar(cv, /* createIfNeeded */ true);
+        idMapper.insert(srcReg, dstReg);
+        digFields(dc, srcReg, dstReg);
+    }
+
+    idMapper.insert(OBJ_RETURN, OBJ_RETURN);
+    if (sh->objEstimatedType(OBJ_RETURN))
+        // clone OBJ_RETURN
+        digFields(dc, OBJ_RETURN, OBJ_RETURN);
+
+    // go through the worklist
+    deepCopy(dc);
+
+    // record the renaming of objects in the trace graph
+    for (const TObjMap::value_type &item : dc.objMap)
+        idMapper.insert(item.first, item.second);
+
+    // the no-return call (if any) is not a part of the heap graph
+    dst.setExitPoint(sh->exitPoint());
+
+#ifndef NDEBUG
+    TObjList objsSrc, objsDst;
+    sh->gatherObjects(objsSrc);
+    dst.gatherObjects(objsDst);
+    if (objsSrc.size() != objsDst.size()) {
+        CL_ERROR("symcut: compactHeapIds() lost some objects, plotting heaps...");
+        plotHeap(*sh, "compact-input");
+        plotHeap( dst, "compact-output");
+        CL_BREAK_IF("symcut: plot done, please consider analyzing the results");
+    }
+#endif
+    CL_DEBUG("compactHeapIds() reduced lastId() from " << lastIdOrig
+            << " to " << dst.lastId());
+
+    *sh = dst;
+}
@@ -23,7 +23,7 @@
 /**
  * @file symcut.hh
  * split/join algorithms operating on symbolic heap - splitHeapByCVars() and
- * joinHeapsByCVars()
+ * joinHeapsByCVars(), and compactHeapIds() built on top of the same deep copy
  */
 
 #include "symheap.hh"
@@ -55,4 +55,12 @@ void joinHeapsByCVars(
         SymHeap                     *srcDst,
         const SymHeap               *src2);
 
+/**
+ * renumber all entities of the given heap, such that their IDs are dense again
+ * @note The heap is expected to contain no junk, which would not be copied.
+ * The renaming of objects is recorded by a Trace::CompactIdsNode.
+ * @param sh the instance of heap to operate on
+ */
+void compactHeapIds(SymHeap *sh);
+
 #endif /* H_GUARD_SYM_CUT_H */
@@ -21,12 +21,15 @@
 #ifndef H_GUARD_SYM_DEBUG_H
 #define H_GUARD_SYM_DEBUG_H
 
+#include <cl/cl_msg.hh>                 // needed for CL_DEBUG_MSGS
+
 #include "symplot.hh"
 
 #include <iomanip>
 #include <string>
 #include <sstream>
 
+#if CL_DEBUG_MSGS
 #define LOCAL_DEBUG_PLOTTER(name, enabled_by_default)                          \
     static bool __ldp_enabled_##name = static_cast<bool>(enabled_by_default);  \
     static int __ldp_cnt_total_##name = -1;                                    \
@@ -68,4 +71,26 @@
 #define LDP_ENABLE(plotter)          __ldp_enable_##plotter()
 #define LDP_DISABLE(plotter)         __ldp_disable_##plotter()
 
+#else // !CL_DEBUG_MSGS
+
+// only the switches are kept, the plots are compiled out with their arguments
+#define LOCAL_DEBUG_PLOTTER(name, enabled_by_default)                          \
+    static bool __ldp_enabled_##name = static_cast<bool>(enabled_by_default);  \
+                                                                               \
+    void __ldp_enable_##name() {                                               \
+        ::__ldp_enabled_##name = true;                                         \
+    }                                                                          \
+                                                                               \
+    void __ldp_disable_##name() {                                              \
+        ::__ldp_enabled_##name = false;                                        \
+    }                                                                          \
+
+#define LDP_INIT(plotter, plot_name) (void) sizeof(plot_name)
+#define LDP_PLOT(plotter, sh)        (void) sizeof(sh)
+#define LDP_PLOTN(plotter, sh, pName)(void) sizeof(pName)
+#define LDP_ENABLE(plotter)          __ldp_enable_##plotter()
+#define LDP_DISABLE(plotter)         __ldp_disable_##plotter()
+
+#endif // CL_DEBUG_MSGS
+
 #endif /* H_GUARD_SYM_DEBUG_H */
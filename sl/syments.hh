@@ -150,6 +150,56 @@ template <enum ERefCntObjKind TKind> struct RefCntLib {
     }
 };
 
+/**
+ * copy-on-write holder of a (possibly big) container.  Copies of the holder
+ * share the container until one of them asks for write access by rw().
+ */
+template <class T>
+class SharedCont {
+    public:
+        SharedCont():
+            d_(new Data)
+        {
+        }
+
+        SharedCont(const SharedCont &ref):
+            d_(ref.d_)
+        {
+            RefCntLib<RCO_NON_VIRT>::enter(d_);
+        }
+
+        ~SharedCont() {
+            RefCntLib<RCO_NON_VIRT>::leave(d_);
+        }
+
+        SharedCont& operator=(const SharedCont &ref) {
+            Data *data = ref.d_;
+            RefCntLib<RCO_NON_VIRT>::enter(data);
+            RefCntLib<RCO_NON_VIRT>::leave(d_);
+            d_ = data;
+            return *this;
+        }
+
+        /// read-only access, never clones the container
+        const T& ro() const {
+            return d_->cont;
+        }
+
+        /// read-write access, clones the container if it is shared
+        T& rw() {
+            RefCntLib<RCO_NON_VIRT>::requireExclusivity(d_);
+            return d_->cont;
+        }
+
+    private:
+        struct Data {
+            RefCounter      refCnt;
+            T               cont;
+        };
+
+        Data               *d_;
+};
+
 struct EntCounter {
 #if SH_PREVENT_AMBIGUOUS_ENT_ID
     long                entCnt;
@@ -162,6 +212,44 @@ struct EntCounter {
 #endif
 };
 
+/// a fixed-size slice of EntStore, shared among the copies until written to
+template <class TBaseEnt>
+struct EntChunk {
+    RefCounter          refCnt;
+    TBaseEnt           *ents[SH_ENT_CHUNK_SIZE];
+
+    EntChunk() {
+        for (TBaseEnt *&ent : ents)
+            ent = 0;
+    }
+
+    EntChunk(const EntChunk &ref) {
+        // the entities are now referenced by one more chunk
+        for (int i = 0; i < SH_ENT_CHUNK_SIZE; ++i) {
+            TBaseEnt *&ent = ents[i];
+            ent = ref.ents[i];
+            if (ent)
+                RefCntLib<RCO_VIRTUAL>::enter(ent);
+        }
+    }
+
+    ~EntChunk() {
+        for (TBaseEnt *&ent : ents)
+            if (ent)
+                RefCntLib<RCO_VIRTUAL>::leave(ent);
+    }
+
+    private:
+        // intentionally not implemented
+        EntChunk& operator=(const EntChunk &);
+};
+
+/**
+ * ID-addressed store of reference-counted entities.  The pointers are kept in
+ * chunks of SH_ENT_CHUNK_SIZE slots, which are shared on copy and cloned on
+ * write one by one.  Copying the store thus costs one reference per chunk
+ * instead of one reference per entity.  NULL chunk means no valid entity.
+ */
 template <class TBaseEnt>
 class EntStore {
     public:
@@ -176,10 +264,15 @@ class EntStore {
 
         template <typename TId> TId lastId() const {
             // we need to be careful with integral arithmetic on enums
-            const long last = -1L + ents_.size();
+            const long last = -1L + size_;
             return static_cast<TId>(last);
         }
 
+        /// count of valid entities (the IDs up to lastId() may contain holes)
+        long cntValid() const {
+            return cntValid_;
+        }
+
         template <typename TId> bool outOfRange(const TId id) const {
             return (this->lastId<TId>() < id) || (id < 0);
         }
@@ -194,16 +287,35 @@ class EntStore {
         inline void getEntRW(TEnt **, TId id);
 
     private:
+        typedef EntChunk<TBaseEnt>              TChunk;
+
         // intentionally not implemented
         EntStore& operator=(const EntStore &);
 
-        std::vector<TBaseEnt *>                 ents_;
+        /// return the slot of the given ID, the chunk must already exist
+        TBaseEnt*& slotRW(long id);
+
+        std::vector<TChunk *>                   chunks_;
+        long                                    size_;
+        long                                    cntValid_;
         EntCounter                             *entCnt_;
 };
 
 
 // /////////////////////////////////////////////////////////////////////////////
 // implementation of EntStore
+template <class TBaseEnt>
+TBaseEnt*& EntStore<TBaseEnt>::slotRW(const long id)
+{
+    TChunk *&chunk = chunks_[id / SH_ENT_CHUNK_SIZE];
+    if (!chunk)
+        chunk = new TChunk;
+    else
+        RefCntLib<RCO_NON_VIRT>::requireExclusivity(chunk);
+
+    return chunk->ents[id % SH_ENT_CHUNK_SIZE];
+}
+
 template <class TBaseEnt>
 template <typename TId>
 TId EntStore<TBaseEnt>::assignId(TBaseEnt *ptr)
@@ -211,12 +323,11 @@ TId EntStore<TBaseEnt>::assignId(TBaseEnt *ptr)
     CL_BREAK_IF(ptr->refCnt.isShared());
 #if SH_PREVENT_AMBIGUOUS_ENT_ID
     const TId id = static_cast<TId>(entCnt_->entCnt);
-    this->assignId(id, ptr);
-    return id;
 #else
-    this->ents_.push_back(ptr);
-    return this->lastId<TId>();
+    const TId id = static_cast<TId>(size_);
 #endif
+    this->assignId(id, ptr);
+    return id;
 }
 
 template <class TBaseEnt>
@@ -226,15 +337,18 @@ void EntStore<TBaseEnt>::assignId(const TId id, TBaseEnt *ptr)
     CL_BREAK_IF(ptr->refCnt.isShared());
 
     // make sure we have enough space allocated
-    if (this->lastId<TId>() < id)
-        ents_.resize(id + 1, 0);
+    if (this->lastId<TId>() < id) {
+        size_ = 1L + id;
+        chunks_.resize((size_ + SH_ENT_CHUNK_SIZE - 1) / SH_ENT_CHUNK_SIZE, 0);
+    }
 
-    TBaseEnt *&ref = ents_[id];
+    TBaseEnt *&ref = this->slotRW(id);
 
     // if this fails, you wanted to overwrite pointer to a valid entity
     CL_BREAK_IF(ref);
 
     ref = ptr;
+    ++cntValid_;
 #if SH_PREVENT_AMBIGUOUS_ENT_ID
     const long cntNow = 1L + id;
     if (entCnt_->entCnt < cntNow)
@@ -246,7 +360,8 @@ template <class TBaseEnt>
 template <typename TId>
 void EntStore<TBaseEnt>::releaseEnt(const TId id)
 {
-    RefCntLib<RCO_VIRTUAL>::leave(ents_[id]);
+    RefCntLib<RCO_VIRTUAL>::leave(this->slotRW(id));
+    --cntValid_;
 }
 
 template <class TBaseEnt>
@@ -256,20 +371,25 @@ bool EntStore<TBaseEnt>::isValidEnt(const TId id) const
     if (this->outOfRange(id))
         return false;
 
-    return !!ents_[id];
+    const TChunk *chunk = chunks_[id / SH_ENT_CHUNK_SIZE];
+    return chunk && chunk->ents[id % SH_ENT_CHUNK_SIZE];
 }
 
 template <class TBaseEnt>
-EntStore<TBaseEnt>::EntStore()
+EntStore<TBaseEnt>::EntStore():
+    size_(0L),
+    cntValid_(0L)
 #if SH_PREVENT_AMBIGUOUS_ENT_ID
-    : entCnt_(new EntCounter)
+    , entCnt_(new EntCounter)
 #endif
 {
 }
 
 template <class TBaseEnt>
 EntStore<TBaseEnt>::EntStore(const EntStore &ref):
-    ents_(ref.ents_)
+    chunks_(ref.chunks_),
+    size_(ref.size_),
+    cntValid_(ref.cntValid_)
 #if SH_PREVENT_AMBIGUOUS_ENT_ID
     , entCnt_(ref.entCnt_)
 #endif
@@ -277,9 +397,9 @@ EntStore<TBaseEnt>::EntStore(const EntStore &ref):
 #if SH_PREVENT_AMBIGUOUS_ENT_ID
     RefCntLib<RCO_NON_VIRT>::enter(entCnt_);
 #endif
-    for (TBaseEnt *&ent : ents_)
-        if (ent)
-            RefCntLib<RCO_VIRTUAL>::enter(ent);
+    for (TChunk *&chunk : chunks_)
+        if (chunk)
+            RefCntLib<RCO_NON_VIRT>::enter(chunk);
 }
 
 template <class TBaseEnt>
@@ -288,9 +408,9 @@ EntStore<TBaseEnt>::~EntStore()
 #if SH_PREVENT_AMBIGUOUS_ENT_ID
     RefCntLib<RCO_NON_VIRT>::leave(entCnt_);
 #endif
-    for (TBaseEnt *ent : ents_)
-        if (ent)
-            RefCntLib<RCO_VIRTUAL>::leave(ent);
+    for (TChunk *&chunk : chunks_)
+        if (chunk)
+            RefCntLib<RCO_NON_VIRT>::leave(chunk);
 }
 
 template <class TBaseEnt>
@@ -301,7 +421,9 @@ inline const TBaseEnt* EntStore<TBaseEnt>::getEntRO(const TId id)
     CL_BREAK_IF(this->outOfRange(id));
 
     // if this fails, the ID is no longer valid
-    const TBaseEnt *ptr = ents_[id];
+    const TChunk *chunk = chunks_[id / SH_ENT_CHUNK_SIZE];
+    CL_BREAK_IF(!chunk);
+    const TBaseEnt *ptr = chunk->ents[id % SH_ENT_CHUNK_SIZE];
     CL_BREAK_IF(!ptr);
     return ptr;
 }
@@ -313,7 +435,7 @@ inline TBaseEnt* EntStore<TBaseEnt>::getEntRW(const TId id)
 #ifndef NDEBUG
     this->getEntRO(id);
 #endif
-    TBaseEnt *&entRW = ents_[id];
+    TBaseEnt *&entRW = this->slotRW(id);
     RefCntLib<RCO_VIRTUAL>::requireExclusivity(entRW);
     return entRW;
 }
@@ -26,11 +26,15 @@
 #include <cl/memdebug.hh>
 #include <cl/storage.hh>
 
+#include "budget.hh"
 #include "fixed_point_proxy.hh"
 #include "glconf.hh"
+#include "microbench.hh"
+#include "perfstats.hh"
 #include "sigcatch.hh"
 #include "symabstract.hh"
 #include "symcall.hh"
+#include "symcut.hh"
 #include "symdebug.hh"
 #include "symproc.hh"
 #include "symstate.hh"
@@ -38,6 +42,9 @@
 #include "symtrace.hh"
 #include "util.hh"
 
+#include <algorithm>
+#include <fstream>
+#include <map>
 #include <queue>
 #include <set>
 #include <sstream>
@@ -84,6 +91,13 @@ class SymExec: public IStatsProvider {
                 const CodeStorage::Insn     &insn,
                 const CodeStorage::Fnc      &fnc);
 
+        bool /* complete */ replayPath(
+                Trace::NodeHandle           *pEndPoint,
+                const SymHeap               &entry,
+                const CodeStorage::Insn     &insn,
+                const CodeStorage::Fnc      &fnc,
+                const TReplayPath           &path);
+
         virtual void printStats() const;
 
     private:
@@ -94,6 +108,20 @@ class SymExec: public IStatsProvider {
 
         void enterCall(SymCallCtx *ctx, SymState &results);
 
+        void execCall(
+                SymState                    &results,
+                const SymHeap               &entry,
+                const CodeStorage::Insn     &insn);
+
+        void runExecStack();
+
+        bool replayCond(
+                SymState                    &dst,
+                SymHeap                     sh,
+                const CodeStorage::Insn     &insnCmp,
+                const CodeStorage::Insn     &insnCnd,
+                const bool                  branch);
+
     private:
         const CodeStorage::Storage              &stor_;
         SymCallCache                            callCache_;
@@ -102,6 +130,8 @@ class SymExec: public IStatsProvider {
 
 // /////////////////////////////////////////////////////////////////////////////
 // SymExecEngine
+typedef std::map<const CodeStorage::Block *, int>   TLoopRounds;
+
 class SymExecEngine: public IStatsProvider {
     public:
         SymExecEngine(
@@ -145,6 +175,7 @@ class SymExecEngine: public IStatsProvider {
 
         SymStateMap                     stateMap_;
         BlockScheduler                  sched_;
+        TLoopRounds                     loopRounds_;
         const CodeStorage::Block        *block_;
         unsigned                        insnIdx_;
         unsigned                        heapIdx_;
@@ -248,9 +279,11 @@ void SymExecEngine::execReturn()
     const SymHeap &origin = localState_[heapIdx_];
     SymHeap sh(origin);
 
-    Trace::Node *trOrig = origin.traceNode();
-    Trace::Node *trRet = new Trace::InsnNode(trOrig, insn, /* bin */ false);
-    sh.traceUpdate(trRet);
+    if (Trace::isRecorded(Trace::TL_FULL)) {
+        Trace::Node *trOrig = origin.traceNode();
+        Trace::Node *trRet = new Trace::InsnNode(trOrig, insn, /* bin */ false);
+        sh.traceUpdate(trRet);
+    }
 
     if (CL_TYPE_VOID != fncReturnType_->code) {
         SymProc proc(sh, &bt_);
@@ -302,7 +335,8 @@ void SymExecEngine::updateState(SymHeap &sh, const CodeStorage::Block *ofBlock)
 {
     const std::string &name = ofBlock->name();
 
-    bool closingLoop = isLoopClosingEdge(/* term */ block_->back(), ofBlock);
+    const bool loopEdge = isLoopClosingEdge(/* term */ block_->back(), ofBlock);
+    bool closingLoop = loopEdge;
     if (closingLoop)
         CL_DEBUG_MSG(lw_, "-L- traversing a loop-closing edge");
 
@@ -312,12 +346,34 @@ void SymExecEngine::updateState(SymHeap &sh, const CodeStorage::Block *ofBlock)
 #endif
         abstractIfNeeded(sh);
 
+#if SE_COMPACT_HEAP_IDS_THR
+    // renumber the heap entities if the ID space has become too sparse
+    if (SE_COMPACT_HEAP_IDS_THR * sh.cntValidIds() < sh.lastId())
+        compactHeapIds(&sh);
+#endif
+
     if (!GlConf::data.joinOnLoopEdgesOnly)
         closingLoop = true;
 
+    // widen at a loop entry that has not converged after the given count of
+    // rounds, i.e. its state still keeps changing via loop-closing edges
+    const int widenAfter = GlConf::data.widenAfter;
+    const bool widen = loopEdge && widenAfter
+        && (widenAfter <= loopRounds_[ofBlock]);
+    if (widen)
+        CL_DEBUG_MSG(lw_, "-W- widening at loop entry " << name);
+
+    // keep a copy of the heap for the micro-benchmark if enabled
+    microBenchCapture(sh, ofBlock);
+
     // update _target_ state and check if anything has changed
-    if (stateMap_.insert(ofBlock, sh, closingLoop)) {
+    const bool changed = stateMap_.insert(ofBlock, sh, closingLoop, widen);
+
+    if (changed) {
         const SymStateMarked &target = stateMap_[ofBlock];
+        if (loopEdge)
+            // one more round of the loop that has not converged yet
+            ++loopRounds_[ofBlock];
 
         // schedule for next wheel (if not already)
         sched_.schedule(ofBlock);
@@ -354,10 +410,11 @@ void SymExecEngine::updateStateInBranch(
 
     // append trace node for a non-deterministic condition
     Trace::waiveCloneOperation(shOrig);
-    shOrig.traceUpdate(new Trace::CondNode(shOrig.traceNode(),
-                &insnCmp, &insnCnd, /* det */ false, branch));
+    if (Trace::isRecorded(Trace::TL_REDUCED))
+        shOrig.traceUpdate(new Trace::CondNode(shOrig.traceNode(),
+                    &insnCmp, &insnCnd, /* det */ false, branch));
 
-#if DEBUG_SE_NONDET_COND < 2
+#if CL_DEBUG_MSGS && DEBUG_SE_NONDET_COND < 2
     const bool hasAbstract = isAnyAbstractOf(shOrig, v1, v2);
 #endif
     const enum cl_binop_e code = static_cast<enum cl_binop_e>(insnCmp.subCode);
@@ -367,7 +424,7 @@ void SymExecEngine::updateStateInBranch(
     CL_BREAK_IF(!dst.size());
 
     for (SymHeap *sh : dst) {
-#if DEBUG_SE_NONDET_COND < 2
+#if CL_DEBUG_MSGS && DEBUG_SE_NONDET_COND < 2
         if (hasAbstract)
 #endif
             LDP_PLOT(nondetCond, *sh);
@@ -396,19 +453,18 @@ bool isTrackableValue(const SymHeap &sh, const TValId val)
     return false;
 }
 
-bool SymExecEngine::bypassNonPointers(
-        SymProc                                     &proc,
+/// true if the result of the comparison is not worth reflecting in the heap
+bool skipTrackingOfCmp(
+        const SymHeap                               &sh,
         const CodeStorage::Insn                     &insnCmp,
-        const CodeStorage::Insn                     &insnCnd,
         const TValId                                v1,
         const TValId                                v2)
 {
-    SymHeap &sh = proc.sh();
     const TObjType clt1 = insnCmp.operands[/* src1 */ 1].type;
     const TObjType clt2 = insnCmp.operands[/* src2 */ 2].type;
 #if SE_TRACK_NON_POINTER_VALUES < 3
     if (isCodePtr(clt1) || isCodePtr(clt2))
-        goto skip_tracking;
+        return true;
 #endif
 
 #if !SE_TRACK_NON_POINTER_VALUES
@@ -420,12 +476,26 @@ bool SymExecEngine::bypassNonPointers(
     if (isTrackableValue(sh, v1) || isTrackableValue(sh, v2))
         return false;
 
-skip_tracking:
+    return true;
+}
+
+bool SymExecEngine::bypassNonPointers(
+        SymProc                                     &proc,
+        const CodeStorage::Insn                     &insnCmp,
+        const CodeStorage::Insn                     &insnCnd,
+        const TValId                                v1,
+        const TValId                                v2)
+{
+    SymHeap &sh = proc.sh();
+    if (!skipTrackingOfCmp(sh, insnCmp, v1, v2))
+        return false;
+
     proc.killInsn(insnCmp);
 
     SymHeap sh1(sh);
-    sh1.traceUpdate(new Trace::CondNode(sh.traceNode(),
-                &insnCmp, &insnCnd, /* det */ false, /* branch */ true));
+    if (Trace::isRecorded(Trace::TL_REDUCED))
+        sh1.traceUpdate(new Trace::CondNode(sh.traceNode(),
+                    &insnCmp, &insnCnd, /* det */ false, /* branch */ true));
 
     CL_DEBUG_MSG(lw_, "-T- CL_INSN_COND updates TRUE branch");
     SymProc proc1(sh1, proc.bt());
@@ -434,8 +504,9 @@ skip_tracking:
     this->updateState(sh1, insnCnd.targets[/* then label */ 0]);
 
     SymHeap sh2(sh);
-    sh2.traceUpdate(new Trace::CondNode(sh.traceNode(),
-                &insnCmp, &insnCnd, /* det */ false, /* branch */ false));
+    if (Trace::isRecorded(Trace::TL_REDUCED))
+        sh2.traceUpdate(new Trace::CondNode(sh.traceNode(),
+                    &insnCmp, &insnCnd, /* det */ false, /* branch */ false));
 
     CL_DEBUG_MSG(lw_, "-F- CL_INSN_COND updates FALSE branch");
     SymProc proc2(sh2, proc.bt());
@@ -487,8 +558,9 @@ void SymExecEngine::execCondInsn()
     // check whether we know where to go
     switch (val) {
         case VAL_TRUE:
-            sh.traceUpdate(new Trace::CondNode(sh.traceNode(),
-                        insnCmp, insnCnd, /* det */ true, /* branch */ true));
+            if (Trace::isRecorded(Trace::TL_REDUCED))
+                sh.traceUpdate(new Trace::CondNode(sh.traceNode(),
+                            insnCmp, insnCnd, /* det */ true, /* branch */ true));
 
             CL_DEBUG_MSG(lw_, ".T. CL_INSN_COND got VAL_TRUE");
             proc.killInsn(*insnCmp);
@@ -497,8 +569,9 @@ void SymExecEngine::execCondInsn()
             return;
 
         case VAL_FALSE:
-            sh.traceUpdate(new Trace::CondNode(sh.traceNode(),
-                        insnCmp, insnCnd, /* det */ true, /* branch */ false));
+            if (Trace::isRecorded(Trace::TL_REDUCED))
+                sh.traceUpdate(new Trace::CondNode(sh.traceNode(),
+                            insnCmp, insnCnd, /* det */ true, /* branch */ false));
 
             CL_DEBUG_MSG(lw_, ".F. CL_INSN_COND got VAL_FALSE");
             proc.killInsn(*insnCmp);
@@ -528,15 +601,17 @@ void SymExecEngine::execCondInsn()
         proc.printBackTrace(ML_WARN);
     }
 
-#if DEBUG_SE_NONDET_COND < 2
+#if CL_DEBUG_MSGS
+#   if DEBUG_SE_NONDET_COND < 2
     if (isAnyAbstractOf(sh, v1, v2))
-#endif
+#   endif
     {
         std::ostringstream str;
         str << "at-line-" << lw_->line;
         LDP_INIT(nondetCond, str.str());
         LDP_PLOT(nondetCond, sh);
     }
+#endif
 
     CL_DEBUG_MSG(lw_, "?T? CL_INSN_COND updates TRUE branch");
     this->updateStateInBranch(sh, true,  *insnCmp, *insnCnd, v1, v2);
@@ -670,6 +745,7 @@ bool /* complete */ SymExecEngine::execInsn()
 
     // go through the remainder of symbolic heaps corresponding to localState_
     const unsigned hCnt = localState_.size();
+    const bool debugHeaps = (1 < hCnt) && CL_DEBUG_ENABLED();
     for (/* we allow resume */; heapIdx_ < hCnt; ++heapIdx_) {
         if (!insnIdx_) {
             if (origin.isDone(heapIdx_))
@@ -680,6 +756,7 @@ bool /* complete */ SymExecEngine::execInsn()
 
             // mark as processed now since it can be re-scheduled right away
             origin.setDone(heapIdx_);
+            perfCount(PC_HEAPS_EXECUTED);
         }
 
         // capture fixed-point for plotting if configured to do so
@@ -690,7 +767,7 @@ bool /* complete */ SymExecEngine::execInsn()
             // this is going to be handled in execCondInsn() right away
             continue;
 
-        if (1 < hCnt) {
+        if (debugHeaps) {
             CL_DEBUG_MSG(lw_, "*** processing block " << block_->name()
                          << ", heap #" << heapIdx_
                          << " (initial size of state was " << hCnt << ")");
@@ -699,6 +776,9 @@ bool /* complete */ SymExecEngine::execInsn()
         // time to respond to a single pending signal
         this->processPendingSignals();
 
+        // degrade precision if we are running out of budget
+        AnalysisBudget::check();
+
         if (this->handleExitPoint(localState_[heapIdx_]))
             // program exited on this execution path, go directly to the caller
             continue;
@@ -743,6 +823,7 @@ bool /* complete */ SymExecEngine::execBlock()
         // fresh run, let's initialize the local state by the BB entry
         const SymState &origin = stateMap_[block_];
         localState_ = origin;
+        perfCount(PC_BLOCKS_EXECUTED);
 
         // eliminate the unneeded Trace::CloneNode instances
         Trace::waiveCloneOperation(localState_);
@@ -802,6 +883,9 @@ void SymExecEngine::joinCallResults()
         // time to respond to a single pending signal
         this->processPendingSignals();
 
+        // degrade precision if we are running out of budget
+        AnalysisBudget::check();
+
         all.insert(callResults_[i]);
     }
 
@@ -1045,8 +1129,14 @@ void SymExecEngine::pruneOrigin()
         goto thr_reached;
 #endif
 
-#if SE_STATE_PRUNING_TOTAL_THR
-    if ((SE_STATE_PRUNING_TOTAL_THR) <= size)
+    if (GlConf::data.statePruningTotalThr
+            && GlConf::data.statePruningTotalThr <= static_cast<int>(size))
+        goto thr_reached;
+
+#if SE_EXTENDED_BASIC_BLOCKS
+    if (2 < GlConf::data.joinOnLoopEdgesOnly && block_->isEbbInterior())
+        // the state is not looked into on insertion, so keep it only while
+        // there are any heaps pending in there
         goto thr_reached;
 #endif
 
@@ -1062,9 +1152,7 @@ void SymExecEngine::pruneOrigin()
         return;
 #endif
 
-#if SE_STATE_PRUNING_MISS_THR || SE_STATE_PRUNING_TOTAL_THR
 thr_reached:
-#endif
     if (0x100 < size)
         printMemUsage("SymExecEngine::execInsn");
 
@@ -1211,6 +1299,46 @@ void SymExec::execFnc(
     this->enterCall(ctx, results);
 
     // main loop
+    this->runExecStack();
+}
+
+void SymExec::execCall(
+        SymState                        &dst,
+        const SymHeap                   &entry,
+        const CodeStorage::Insn         &insn)
+{
+    const CodeStorage::Fnc *fnc = this->resolveCallInsn(dst, entry, insn);
+
+    SymCallCtx *ctx = 0;
+    if (fnc)
+        // call cache lookup
+        ctx = callCache_.getCallCtx(entry, *fnc, insn);
+
+    if (!ctx)
+        // the error message should have been already emitted, but there
+        // are probably some unknown values in the result
+        return;
+
+    if (!ctx->needExec()) {
+        // call cache hit
+        perfCount(PC_CALL_CACHE_HITS);
+        const struct cl_loc *loc = &insn.loc;
+        const std::string name = nameOf(*fnc);
+        CL_DEBUG_MSG(loc,
+                "(x) call of function optimized out: " << name << "()");
+
+        // use the cached result
+        ctx->flushCallResults(dst);
+        return;
+    }
+
+    // create a new engine and push it to the exec stack
+    perfCount(PC_CALL_CACHE_MISSES);
+    this->enterCall(ctx, dst);
+}
+
+void SymExec::runExecStack()
+{
     while (!execStack_.empty()) {
         const ExecStackItem &item = execStack_.front();
         SymExecEngine *engine = item.eng;
@@ -1241,45 +1369,243 @@ void SymExec::execFnc(
         }
 
         // function call requested
-        // --> we need to nest unless the computed result is already available
+        // --> we need to nest unless the computed result is already available,
+        // otherwise the caller is woken up in the next iteration
         SymState &dst = engine->callResults();
         const SymHeap &entry = engine->callEntry();
         const CodeStorage::Insn &insn = engine->callInsn();
-        const CodeStorage::Fnc *fnc = this->resolveCallInsn(dst, entry, insn);
+        this->execCall(dst, entry, insn);
+    }
+}
 
-        SymCallCtx *ctx = 0;
-        if (fnc)
-            // call cache lookup
-            ctx = callCache_.getCallCtx(entry, *fnc, insn);
+bool /* feasible */ SymExec::replayCond(
+        SymState                        &dst,
+        SymHeap                         sh,
+        const CodeStorage::Insn         &insnCmp,
+        const CodeStorage::Insn         &insnCnd,
+        const bool                      branch)
+{
+    CL_BREAK_IF(CL_INSN_BINOP != insnCmp.code);
+    CL_BREAK_IF(CL_INSN_COND != insnCnd.code);
+    const struct cl_loc *lw = &insnCnd.loc;
 
-        if (!ctx)
-            // the error message should have been already emitted, but there
-            // are probably some unknown values in the result; now wake up
-            // the caller
-            continue;
+    const SymExecCoreParams ep(GlConf::data);
+    SymExecCore proc(sh, &callCache_.bt(), ep);
+    proc.setLocation(lw);
 
-        if (!ctx->needExec()) {
-            // call cache hit
-            const struct cl_loc *loc = &insn.loc;
-            const std::string name = nameOf(*fnc);
-            CL_DEBUG_MSG(loc,
-                    "(x) call of function optimized out: " << name << "()");
+    // compute the result of CL_INSN_BINOP
+    const enum cl_binop_e code = static_cast<enum cl_binop_e>(insnCmp.subCode);
+    const TValId v1 = proc.valFromOperand(insnCmp.operands[/* src1 */ 1]);
+    const TValId v2 = proc.valFromOperand(insnCmp.operands[/* src2 */ 2]);
+    const TValId val = compareValues(sh, code, v1, v2);
+
+    const bool det = (VAL_TRUE == val || VAL_FALSE == val);
+    if (det && (VAL_TRUE == val) != branch)
+        // the branch cannot be taken with this heap
+        return false;
 
-            // use the cached result
-            ctx->flushCallResults(dst);
+    sh.traceUpdate(new Trace::CondNode(sh.traceNode(),
+                &insnCmp, &insnCnd, det, branch));
 
-            // wake up the caller
-            continue;
+    SymHeapList results;
+    if (det || skipTrackingOfCmp(sh, insnCmp, v1, v2)) {
+        results.insert(sh);
+    }
+    else if (!reflectCmpResult(results, proc, code, branch, v1, v2))
+        CL_DEBUG_MSG(lw, "XXX unable to reflect comparison result");
+
+    for (SymHeap *res : results) {
+        SymProc procRes(*res, &callCache_.bt());
+        procRes.setLocation(lw);
+        procRes.killInsn(insnCmp);
+        procRes.killPerTarget(insnCnd, /* targetIdx */ !branch);
+        dst.insert(*res);
+    }
+
+    return 0U < results.size();
+}
+
+/// true if the path takes a decision at the given step or later
+static bool hasDecisionsFrom(const TReplayPath &path, size_t idx)
+{
+    // the last step only names the block where the path ends
+    for (; idx + 1U < path.size(); ++idx)
+        if (CL_INSN_COND == path[idx].bb->back()->code)
+            return true;
+
+    return false;
+}
+
+bool /* complete */ SymExec::replayPath(
+        Trace::NodeHandle               *pEndPoint,
+        const SymHeap                   &entry,
+        const CodeStorage::Insn         &insn,
+        const CodeStorage::Fnc          &fnc,
+        const TReplayPath               &path)
+{
+    SymCallCtx *ctx = callCache_.getCallCtx(entry, fnc, insn);
+    CL_BREAK_IF(!ctx || !ctx->needExec());
+
+    const SymExecCoreParams ep(GlConf::data);
+    const struct cl_loc *lw = locationOf(fnc);
+    bool complete = true;
+
+    SymHeapList state;
+    state.insert(ctx->entry());
+
+    const CodeStorage::Block *bb = fnc.cfg.entry();
+    for (const ReplayStep &step : path) {
+        if (step.bb != bb) {
+            CL_ERROR_MSG(lw, "decision log does not match the control flow of "
+                    << nameOf(fnc) << "()");
+            complete = false;
+            break;
         }
 
-        // create a new engine and push it to the exec stack
-        this->enterCall(ctx, dst);
+        const bool anyHeap = (REPLAY_ANY_HEAP == step.heapIdx);
+        if (anyHeap)
+            CL_DEBUG_MSG(lw, "=== replaying " << bb->name()
+                    << ", any heap, branch " << step.branch);
+        else
+            CL_DEBUG_MSG(lw, "=== replaying " << bb->name() << ", heap #"
+                    << step.heapIdx << ", branch " << step.branch);
+
+        // go through the non-terminal instructions, except the one that
+        // computes the condition (it is handled by replayCond())
+        const CodeStorage::Insn *term = bb->back();
+        unsigned cntNonTerm = bb->size() - 1U;
+        if (CL_INSN_COND == term->code)
+            --cntNonTerm;
+
+        for (unsigned i = 0; i < cntNonTerm && state.size(); ++i) {
+            const CodeStorage::Insn *insn = bb->operator[](i);
+            if (0 < insn->loc.line)
+                lw = &insn->loc;
+
+            // the heap to follow, or the last one if there are not enough
+            const size_t cnt = state.size();
+            const size_t idxFollow = (anyHeap)
+                ? 0U
+                : std::min<size_t>(step.heapIdx, cnt - 1U);
+
+            bool terminated = false;
+            SymHeapList next;
+            for (size_t idx = 0U; idx < cnt; ++idx) {
+                SymHeap sh(state[idx]);
+                Trace::waiveCloneOperation(sh);
+
+                const size_t cntNext = next.size();
+                SymExecCore core(sh, &callCache_.bt(), ep);
+                core.setLocation(lw);
+                if (!core.exec(next, *insn)) {
+                    // analyse the called function as a whole
+                    this->execCall(next, sh, *insn);
+                    this->runExecStack();
+                }
+
+                if (anyHeap && !terminated && cntNext == next.size()) {
+                    // the heap has no results, most likely because of an
+                    // error, which is what we are looking for
+                    pEndPoint->reset(sh.traceNode());
+                    terminated = true;
+                }
+                else if (idx == idxFollow && !terminated)
+                    // keep the followed heap, it may end up with an error
+                    pEndPoint->reset(sh.traceNode());
+            }
+
+            state.swap(next);
+        }
+
+        if (!state.size()) {
+            // the path has been terminated, most likely by an error, which is
+            // the expected end of the path unless there are decisions left
+            complete = !hasDecisionsFrom(path, &step - &path.front());
+            break;
+        }
+
+        if (!anyHeap && state.size() <= step.heapIdx) {
+            CL_ERROR_MSG(lw, "heap #" << step.heapIdx << " does not exist at "
+                    << bb->name() << " (only " << state.size() << " heaps)");
+            complete = false;
+            break;
+        }
+
+        if (CL_INSN_COND == term->code && &step != &path.back()) {
+            // take the given heap, or the first one on which the decision is
+            // feasible; with REPLAY_ANY_HEAP, take all the heaps it is feasible
+            // on because the path may continue with any of them
+            const CodeStorage::Insn *cmp = bb->operator[](cntNonTerm);
+            const size_t cnt = state.size();
+            SymHeapList taken;
+            for (size_t i = 0U; i < cnt; ++i) {
+                size_t idx = i;
+                if (!anyHeap)
+                    idx = (!i) ? step.heapIdx : (i - (i <= step.heapIdx));
+
+                SymHeap sh(state[idx]);
+                Trace::waiveCloneOperation(sh);
+                if (!this->replayCond(taken, sh, *cmp, *term, step.branch)
+                        || anyHeap)
+                    continue;
+
+                if (idx != step.heapIdx)
+                    CL_NOTE_MSG(&term->loc, "replayed branch is infeasible "
+                            "with heap #" << step.heapIdx
+                            << ", following heap #" << idx);
+                break;
+            }
+
+            if (!taken.size()) {
+                CL_ERROR_MSG(&term->loc, "replayed branch is infeasible");
+                complete = false;
+                break;
+            }
+
+            state.swap(taken);
+            pEndPoint->reset(state[0].traceNode());
+            bb = term->targets[/* then/else */ !step.branch];
+        }
+        else {
+            if (!anyHeap) {
+                // follow the given heap only
+                SymHeap sh(state[step.heapIdx]);
+                Trace::waiveCloneOperation(sh);
+                state.clear();
+                state.insert(sh);
+                pEndPoint->reset(state[0].traceNode());
+            }
+
+            bb = (CL_INSN_JMP == term->code)
+                ? term->targets[/* target */ 0]
+                // CL_INSN_RET or CL_INSN_ABORT, nowhere to go
+                : 0;
+        }
+
+        if (!bb)
+            continue;
+
+#if SE_ABSTRACT_ON_LOOP_EDGES_ONLY
+        if (!isLoopClosingEdge(term, bb))
+            continue;
+#endif
+        // the decisions may depend on abstraction the same way as they do in
+        // SymExecEngine::updateState()
+        for (SymHeap *sh : state)
+            abstractIfNeeded(*sh);
     }
+
+    // leave the call context, we are not going to return to the caller
+    SymHeapList dummy;
+    ctx->flushCallResults(dummy);
+    ctx->invalidate();
+    return complete;
 }
 
 void SymExec::printStats() const
 {
-    // TODO: print SymCallCache stats here as soon as we have implemented some
+    // statistics of the call cache
+    callCache_.printStats();
 
     for (const ExecStackItem &item : execStack_) {
         const IStatsProvider *provider = item.eng;
@@ -1309,14 +1635,9 @@ void execTopCall(
     }
 }
 
-void execute(
-        SymState                        &results,
-        const SymHeap                   &entry,
-        const CodeStorage::Fnc          &fnc)
+/// the insn needs to outlive the analysis as trace graph nodes may refer to it
+const CodeStorage::Insn& topCallInsn(const CodeStorage::Fnc &fnc)
 {
-    if (!installSignalHandlers())
-        CL_WARN("unable to install signal handlers");
-
     // XXX: synthesize CL_INSN_CALL
     static CodeStorage::Insn insn;
     insn.stor = fnc.stor;
@@ -1325,8 +1646,19 @@ void execute(
     insn.loc  = *locationOf(fnc);
     insn.operands.resize(2);
     insn.operands[1] = fnc.def;
+    return insn;
+}
+
+void execute(
+        SymState                        &results,
+        const SymHeap                   &entry,
+        const CodeStorage::Fnc          &fnc)
+{
+    if (!installSignalHandlers())
+        CL_WARN("unable to install signal handlers");
 
     // run the symbolic execution
+    const CodeStorage::Insn &insn = topCallInsn(fnc);
     execTopCall(results, entry, insn, fnc);
     printMemUsage("SymExec::~SymExec");
 
@@ -1334,3 +1666,181 @@ void execute(
     if (!SignalCatcher::cleanup())
         CL_WARN("unable to restore previous signal handlers");
 }
+
+bool readReplayPath(
+        TReplayPath                     *pDst,
+        const CodeStorage::Fnc          &fnc,
+        const std::string               &fileName)
+{
+    const struct cl_loc *loc = locationOf(fnc);
+    std::ifstream str(fileName.c_str());
+    if (!str) {
+        CL_ERROR_MSG(loc, "unable to read decision log: " << fileName);
+        return false;
+    }
+
+    std::string line;
+    for (int lineNo = 1; std::getline(str, line); ++lineNo) {
+        std::istringstream lstr(line);
+        std::string name;
+        if (!(lstr >> name) || '#' == name[0])
+            // empty line or comment
+            continue;
+
+        ReplayStep step;
+        step.bb = 0;
+        step.heapIdx = 0;
+        step.branch = false;
+
+        std::string idx;
+        bool ok = !!(lstr >> idx >> step.branch);
+        if (ok && "*" == idx)
+            step.heapIdx = REPLAY_ANY_HEAP;
+        else if (ok)
+            ok = !!(std::istringstream(idx) >> step.heapIdx);
+
+        if (!ok) {
+            CL_ERROR(fileName << ":" << lineNo << ": malformed replay step");
+            return false;
+        }
+
+        for (const CodeStorage::Block *bb : fnc.cfg)
+            if (name == bb->name())
+                step.bb = bb;
+
+        if (!step.bb) {
+            CL_ERROR(fileName << ":" << lineNo << ": basic block " << name
+                    << " not found in " << nameOf(fnc) << "()");
+            return false;
+        }
+
+        pDst->push_back(step);
+    }
+
+    return true;
+}
+
+/// write a step per block ending with CL_INSN_JMP, from bb up to the given one
+static const CodeStorage::Block* writeJmpSteps(
+        std::ostream                    &str,
+        const CodeStorage::Block        *bb,
+        const CodeStorage::Block        *upTo)
+{
+    std::set<const CodeStorage::Block *> seen;
+    while (bb != upTo) {
+        const CodeStorage::Insn *term = bb->back();
+        if (CL_INSN_JMP != term->code || !insertOnce(seen, bb))
+            // the control flow cannot reach upTo without a decision
+            return bb;
+
+        str << bb->name() << " * 0\n";
+        bb = term->targets[/* target */ 0];
+    }
+
+    return bb;
+}
+
+/// the predecessor of node along the path that has reached it
+static Trace::Node* decisionParent(Trace::Node *node)
+{
+    if (dynamic_cast<Trace::CallCacheHitNode *>(node))
+        // pathParent() goes to the path that has computed the cached result,
+        // the entry of the call continues the path we are interested in
+        return node->parents().front();
+
+    if (dynamic_cast<Trace::JoinNode *>(node))
+        return node->parents().back();
+
+    return node->pathParent();
+}
+
+bool writeDecisionLog(const std::string &fileName, Trace::Node *endPoint)
+{
+    if (!Trace::isRecorded(Trace::TL_REDUCED)) {
+        CL_WARN("decision log needs trace_level 1 at least: " << fileName);
+        return false;
+    }
+
+    // collect the branching along the path
+    std::vector<const Trace::CondNode *> conds;
+    Trace::Node *node = endPoint;
+    for (; !node->parents().empty(); node = decisionParent(node))
+        if (const Trace::CondNode *cn = dynamic_cast<Trace::CondNode *>(node))
+            conds.push_back(cn);
+
+    const Trace::RootNode *root = dynamic_cast<Trace::RootNode *>(node);
+    if (!root) {
+        CL_WARN("no root of the trace to write decision log: " << fileName);
+        return false;
+    }
+
+    std::ofstream str(fileName.c_str());
+    if (!str) {
+        CL_ERROR("unable to write decision log: " << fileName);
+        return false;
+    }
+
+    const CodeStorage::Fnc &fnc = *root->rootFnc();
+    str << "# decision log of a path through " << nameOf(fnc) << "()\n";
+
+    const CodeStorage::Block *bb = fnc.cfg.entry();
+    for (int i = conds.size() - 1; 0 <= i; --i) {
+        const CodeStorage::Insn *inCnd = conds[i]->inCnd();
+        if (inCnd->bb->cfg() != &fnc.cfg)
+            // branching in a called function, it is analysed as a whole
+            continue;
+
+        // follow the jumps up to the block with the condition
+        bb = writeJmpSteps(str, bb, inCnd->bb);
+        if (bb != inCnd->bb) {
+            CL_WARN("decision log does not match the control flow: "
+                    << fileName);
+            return false;
+        }
+
+        const bool branch = conds[i]->branch();
+        str << bb->name() << " * " << branch << "\n";
+        bb = inCnd->targets[/* then/else */ !branch];
+    }
+
+    // follow the jumps after the last decision (towards the error)
+    bb = writeJmpSteps(str, bb, /* up to the end */ 0);
+    if (bb)
+        str << bb->name() << " * 0\n";
+
+    return !!str;
+}
+
+bool replayPath(
+        const SymHeap                   &entry,
+        const CodeStorage::Fnc          &fnc,
+        const TReplayPath               &path)
+{
+    // the replayed path is traced in full detail regardless of trace_level
+    const int traceLevel = GlConf::data.traceLevel;
+    GlConf::data.traceLevel = Trace::TL_FULL;
+
+    Trace::NodeHandle trEnd(entry.traceNode());
+    bool complete;
+    try {
+        SymExec se(entry.stor());
+        complete = se.replayPath(&trEnd, entry, topCallInsn(fnc), fnc, path);
+    }
+    catch (...) {
+        GlConf::data.traceLevel = traceLevel;
+        throw;
+    }
+
+    GlConf::data.traceLevel = traceLevel;
+
+    const struct cl_loc *loc = locationOf(fnc);
+    if (!complete)
+        CL_NOTE_MSG(loc, "replay of " << nameOf(fnc)
+                << "() terminated prematurely");
+
+    // print and plot the trace leading to the end point of the replayed path
+    Trace::Node *endPoint = trEnd.node();
+    Trace::printTrace(endPoint);
+    Trace::plotTrace(endPoint, "replay");
+    return complete;
+}
@@ -25,17 +25,78 @@
  * SymExec - top level algorithm of the @b symbolic @b execution
  */
 
+#include <string>
+#include <vector>
+
 class SymHeap;
 class SymState;
 
 namespace CodeStorage {
+    struct Block;
     struct Fnc;
     struct Storage;
 }
 
+namespace Trace {
+    class Node;
+}
+
 void execute(
         SymState                        &results,
         const SymHeap                   &entry,
         const CodeStorage::Fnc          &fnc);
 
+/// ReplayStep::heapIdx if the heap to follow is not known, see replayPath()
+const unsigned REPLAY_ANY_HEAP = static_cast<unsigned>(-1);
+
+/// a single decision taken on a path being replayed, see replayPath()
+struct ReplayStep {
+    const CodeStorage::Block   *bb;        ///< basic block being entered
+    unsigned                    heapIdx;   ///< heap to follow at end of the bb
+    bool                        branch;    ///< true for 'then', false 'else'
+};
+
+typedef std::vector<ReplayStep>                     TReplayPath;
+
+/**
+ * read a decision log, one step per line in the form "BLOCK HEAP_IDX BRANCH",
+ * where BLOCK is a name of basic block of the given function, HEAP_IDX is an
+ * index of the heap to follow (or '*' if not known) and BRANCH is 1 for the
+ * 'then' target (ignored unless the block ends with CL_INSN_COND); the last step
+ * only names the block where the path ends; empty lines and '#' are skipped
+ */
+bool readReplayPath(
+        TReplayPath                     *pDst,
+        const CodeStorage::Fnc          &fnc,
+        const std::string               &fileName);
+
+/**
+ * write a decision log (see readReplayPath()) of the path through the root
+ * function leading to the given trace graph node, the last step of the log
+ * names the block where the path ends
+ * @note the branching is taken from CondNode objects, so the trace graph needs
+ * to be recorded with trace_level 1 at least; the trace does not tell which
+ * result of an instruction the path follows, so '*' is written as heap index
+ * @return true if the decision log has been written
+ */
+bool writeDecisionLog(const std::string &fileName, Trace::Node *endPoint);
+
+/**
+ * re-execute a single path through the given function and print/plot the full
+ * trace leading to its end point, regardless of the trace_level option
+ * @param entry the initial state as it would be given to execute()
+ * @param fnc the function that the path goes through
+ * @param path the decisions to take, starting at the entry block of fnc
+ * @note functions called along the path are analysed as a whole, their results
+ * are counted by heapIdx the same way as the results of any other instruction;
+ * with REPLAY_ANY_HEAP all the heaps on which the decisions are feasible are
+ * kept, otherwise an infeasible decision falls back to the other heaps
+ * @return true if the whole path has been replayed successfully, including a
+ * path that is terminated (e.g. by an error) after its last decision
+ */
+bool replayPath(
+        const SymHeap                   &entry,
+        const CodeStorage::Fnc          &fnc,
+        const TReplayPath               &path);
+
 #endif /* H_GUARD_SYM_EXEC_H */
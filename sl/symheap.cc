@@ -26,6 +26,8 @@
 #include <cl/storage.hh>
 
 #include "intarena.hh"
+#include "mempool.hh"
+#include "perfstats.hh"
 #include "symbt.hh"
 #include "syments.hh"
 #include "sympred.hh"
@@ -342,11 +344,25 @@ inline EBlockKind bkFromClt(const TObjType clt)
         : BK_FIELD;
 }
 
+/// recycles memory of heap entities, which are allocated and freed very often
+static MemPool entPool(&perfCounters[PC_ENT_MALLOCS]);
+
 class AbstractHeapEntity {
     public:
         // NVI to catch missing/incorrect overrides of doClone()
         AbstractHeapEntity* clone() const;
 
+        // the entities are allocated from entPool (not meant to be thread-safe)
+        static void* operator new(size_t size) {
+            perfCount(PC_ENT_ALLOCS);
+            return entPool.alloc(size);
+        }
+
+        // the size is that of the dynamic type thanks to the virtual destructor
+        static void operator delete(void *ptr, size_t size) {
+            entPool.release(ptr, size);
+        }
+
     private:
         // see Herb Sutter: C++ Coding Standards (rules #39 and #54) for details
         virtual AbstractHeapEntity* doClone() const = 0;
@@ -520,8 +536,8 @@ struct Region: public AbstractHeapEntity {
     CVar                            cVar;
     CallInst                        anonStackOf;
     TSizeRange                      size;
-    TLiveObjs                       liveFields;
-    TFldIdSet                       usedByGl;
+    SharedCont<TLiveObjs>           liveFields;
+    SharedCont<TFldIdSet>           usedByGl;
     TArena                          arena;
     TObjType                        lastKnownClt;
     bool                            isValid;
@@ -770,7 +786,7 @@ bool /* wasPtr */ SymHeapCore::Private::releaseValueOf(TFldId fld, TValId val)
     Region *regData;
     this->ents.getEntRW(&regData, rootData->obj);
 
-    if (1 != regData->usedByGl.erase(fld))
+    if (1 != regData->usedByGl.rw().erase(fld))
         CL_BREAK_IF("SymHeapCore::Private::releaseValueOf(): offset detected");
 
     return /* wasPtr */ true;
@@ -798,7 +814,7 @@ void SymHeapCore::Private::registerValueOf(TFldId fld, TValId val)
     // update usedByGl
     Region *regData;
     this->ents.getEntRW(&regData, rootData->obj);
-    regData->usedByGl.insert(fld);
+    regData->usedByGl.rw().insert(fld);
 }
 
 // runs only in debug build
@@ -871,10 +887,10 @@ bool SymHeapCore::Private::chkArenaConsistency(
 
     if (!rootData->isValid)
         // invalid objects ... just check there are no outgoing has-value edges
-        return rootData->liveFields.empty();
+        return rootData->liveFields.ro().empty();
 
     std::set<TOffset> offs;
-    for (TLiveObjs::const_reference item : rootData->liveFields) {
+    for (TLiveObjs::const_reference item : rootData->liveFields.ro()) {
         const BlockEntity *blData;
         this->ents.getEntRO(&blData, /* fld */ item.first);
         CL_BREAK_IF(!blData->size);
@@ -892,7 +908,7 @@ bool SymHeapCore::Private::chkArenaConsistency(
             CL_BREAK_IF("two uniform blocks share the same offset");
     }
 
-    TLiveObjs all(rootData->liveFields);
+    TLiveObjs all(rootData->liveFields.ro());
     const TArena &arena = rootData->arena;
     const TMemChunk chunk(0, rootData->size.hi);
 
@@ -951,7 +967,7 @@ void SymHeapCore::Private::splitBlockByObject(
 
     if (blBegToObjBeg <= 0 && objEndToBlEnd <= 0) {
         // block completely overlapped by the object, throw it away
-        if (!rootData->liveFields.erase(block))
+        if (!rootData->liveFields.rw().erase(block))
             CL_BREAK_IF("attempt to kill an already dead uniform block");
 
         rootData->arena -= createArenaItem(blOff, blSize, block);
@@ -981,7 +997,7 @@ void SymHeapCore::Private::splitBlockByObject(
                 objEndToBlEnd,
                 blOther);
 
-        rootData->liveFields[blOther] = BK_UNIFORM;
+        rootData->liveFields.rw()[blOther] = BK_UNIFORM;
         return;
     }
 
@@ -1244,7 +1260,7 @@ void SymHeapCore::Private::reinterpretObjData(
     }
 
     // mark the object as dead
-    if (rootData->liveFields.erase(old))
+    if (rootData->liveFields.rw().erase(old))
         CL_DEBUG("reinterpretObjData() kills a live object");
 
     if (!oldData->extRefCnt) {
@@ -1342,7 +1358,7 @@ void SymHeapCore::Private::fldDestroy(TFldId fld, bool removeVal, bool detach)
         const TSizeOf size = blData->size;
         rootData->arena -= createArenaItem(off, size, fld);
 
-        CL_BREAK_IF(hasKey(rootData->liveFields, fld));
+        CL_BREAK_IF(hasKey(rootData->liveFields.ro(), fld));
         CL_BREAK_IF(!this->chkArenaConsistency(rootData, /* overlap */true));
     }
 
@@ -1506,7 +1522,7 @@ void SymHeapCore::Private::transferBlock(
             CL_BREAK_IF(hbDataSrc->size <= sizeLimit || sizeLimit <= 0);
         }
 
-        if (!hasKey(rootDataSrc->liveFields, objSrc))
+        if (!hasKey(rootDataSrc->liveFields.ro(), objSrc))
             // dead object anyway
             continue;
 
@@ -1581,7 +1597,7 @@ TValId SymHeapCore::Private::fldInit(TFldId fld)
             this->ents.getEntRO(&blockData, other);
 
             const EBlockKind code = blockData->code;
-            if (BK_UNIFORM != code && !hasKey(rootData->liveFields, other))
+            if (BK_UNIFORM != code && !hasKey(rootData->liveFields.ro(), other))
                 continue;
 
             // reinterpret _self_ by another live object or uniform block
@@ -1596,7 +1612,7 @@ TValId SymHeapCore::Private::fldInit(TFldId fld)
     fldData->value = val;
 
     // mark the object as live
-    rootData->liveFields[fld] = BK_FIELD;
+    rootData->liveFields.rw()[fld] = BK_FIELD;
 
     CL_BREAK_IF(!this->chkArenaConsistency(rootData));
 
@@ -1680,7 +1696,7 @@ void SymHeapCore::usedBy(FldList &dst, TValId val, bool liveOnly) const
         d->ents.getEntRO(&rootData, fldData->obj);
 
         // check if the object is alive
-        if (hasKey(rootData->liveFields, fld))
+        if (hasKey(rootData->liveFields.ro(), fld))
             dst.push_back(FldHandle(*const_cast<SymHeapCore *>(this), fld));
     }
 }
@@ -1700,7 +1716,7 @@ void SymHeapCore::pointedBy(FldList &dst, TObjId obj) const
     const Region *regData;
     d->ents.getEntRO(&regData, obj);
 
-    const TFldIdSet &usedBy = regData->usedByGl;
+    const TFldIdSet &usedBy = regData->usedByGl.ro();
     for (const TFldId fld : usedBy)
         dst.push_back(FldHandle(*const_cast<SymHeapCore *>(this), fld));
 }
@@ -1709,7 +1725,7 @@ unsigned SymHeapCore::pointedByCount(TObjId obj) const
 {
     const Region *regData;
     d->ents.getEntRO(&regData, obj);
-    return regData->usedByGl.size();
+    return regData->usedByGl.ro().size();
 }
 
 unsigned SymHeapCore::lastId() const
@@ -1717,6 +1733,11 @@ unsigned SymHeapCore::lastId() const
     return d->ents.lastId<unsigned>();
 }
 
+unsigned SymHeapCore::cntValidIds() const
+{
+    return d->ents.cntValid();
+}
+
 TFldId SymHeapCore::Private::copySingleLiveBlock(
         const TObjId                objDst,
         Region                     *objDataDst,
@@ -1758,7 +1779,7 @@ TFldId SymHeapCore::Private::copySingleLiveBlock(
     }
 
     // prevserve live object code
-    objDataDst->liveFields[dst] = code;
+    objDataDst->liveFields.rw()[dst] = code;
     return dst;
 }
 
@@ -1788,7 +1809,7 @@ TObjId SymHeapCore::objClone(TObjId obj)
         d->liveObjs->insert(dup);
     }
 
-    for (TLiveObjs::const_reference item : objDataSrc->liveFields)
+    for (TLiveObjs::const_reference item : objDataSrc->liveFields.ro())
         d->copySingleLiveBlock(dup, objDataDst,
                 /* src  */ item.first,
                 /* code */ item.second);
@@ -1802,7 +1823,7 @@ void SymHeapCore::gatherUniformBlocks(TUniBlockMap &dst, TObjId obj) const
     const Region *regData;
     d->ents.getEntRO(&regData, obj);
 
-    for (TLiveObjs::const_reference item : regData->liveFields) {
+    for (TLiveObjs::const_reference item : regData->liveFields.ro()) {
         const EBlockKind code = item.second;
         if (BK_UNIFORM != code)
             continue;
@@ -1825,7 +1846,7 @@ void SymHeapCore::gatherLiveFields(FldList &dst, TObjId obj) const
     const Region *regData;
     d->ents.getEntRO(&regData, obj);
 
-    for (TLiveObjs::const_reference item : regData->liveFields) {
+    for (TLiveObjs::const_reference item : regData->liveFields.ro()) {
         const EBlockKind code = item.second;
 
         switch (code) {
@@ -2015,7 +2036,7 @@ void SymHeapCore::setValOfField(TFldId fld, TValId val, TValSet *killedPtrs)
     // mark the destination object as live
     Region *regData;
     d->ents.getEntRW(&regData, fldData->obj);
-    regData->liveFields[fld] = bkFromClt(clt);
+    regData->liveFields.rw()[fld] = bkFromClt(clt);
 
     // now set the value
     d->setValueOf(fld, val, killedPtrs);
@@ -2043,7 +2064,7 @@ TFldId SymHeapCore::Private::writeUniformBlock(
     CL_BREAK_IF(!this->chkArenaConsistency(regData));
 
     // mark the block as live
-    regData->liveFields[fld] = BK_UNIFORM;
+    regData->liveFields.rw()[fld] = BK_UNIFORM;
 
     TArena &arena = regData->arena;
     arena += createArenaItem(ub.off, ub.size, fld);
@@ -2122,7 +2143,7 @@ void SymHeapCore::copyBlockOfRawMemory(
     CL_BREAK_IF(!d->chkArenaConsistency(regDataDst));
 
     // remove the dummy block we used just to trigger the data reinterpretation
-    regDataDst->liveFields.erase(blKiller);
+    regDataDst->liveFields.rw().erase(blKiller);
     regDataDst->arena -= createArenaItem(dstOff, size, blKiller);
     d->ents.releaseEnt(blKiller);
     CL_BREAK_IF(!d->chkArenaConsistency(regDataDst));
@@ -2745,7 +2766,7 @@ void SymHeapCore::rewriteTargetOfBase(TValId root, TObjId objNew)
 
     // go through fields pointing to objOld
     TFldIdSet unrelatedFlds;
-    for (const TFldId fld : regDataOld->usedByGl) {
+    for (const TFldId fld : regDataOld->usedByGl.ro()) {
         // read value of the field
         const FieldOfObj *fldData;
         d->ents.getEntRO(&fldData, fld);
@@ -2756,13 +2777,13 @@ void SymHeapCore::rewriteTargetOfBase(TValId root, TObjId objNew)
         d->ents.getEntRO(&valData, val);
         if (valData->valRoot == root)
             // reference moved
-            regDataNew->usedByGl.insert(fld);
+            regDataNew->usedByGl.rw().insert(fld);
         else
             unrelatedFlds.insert(fld);
     }
 
     // write unmoved field IDs
-    regDataOld->usedByGl.swap(unrelatedFlds);
+    regDataOld->usedByGl.rw().swap(unrelatedFlds);
 }
 
 bool isUninitialized(EValueOrigin code)
@@ -3136,7 +3157,7 @@ TFldId SymHeapCore::Private::fldLookup(
                 continue;
         }
 
-        const bool isLive = hasKey(rootData->liveFields, fld);
+        const bool isLive = hasKey(rootData->liveFields.ro(), fld);
         const FieldOfObj *fldData = DCAST<const FieldOfObj *>(blData);
         if (!/* continue */policy->matchBlock(fld, fldData, isLive))
             break;
@@ -3280,7 +3301,7 @@ void SymHeapCore::fldLeave(TFldId fld)
     const Region *regData;
     d->ents.getEntRO(&regData, fldData->obj);
 
-    if (!hasKey(regData->liveFields, fld)) {
+    if (!hasKey(regData->liveFields.ro(), fld)) {
         CL_DEBUG("SymHeapCore::fldLeave() destroys a dead field");
         d->fldDestroy(fld, /* removeVal */ true, /* detach */ true);
     }
@@ -3473,7 +3494,7 @@ void SymHeapCore::objSetSize(TObjId obj, const TSizeRange &newSize)
             // destroy all inner objects
             for (const TFldId fld : allObjs) {
                 // mark the object as dead
-                if (regData->liveFields.erase(fld))
+                if (regData->liveFields.rw().erase(fld))
                     CL_DEBUG("objSetSize() kills a live object");
                 d->fldDestroy(fld, /* removeVal */ true, /* detach */ true);
             }
@@ -3605,7 +3626,7 @@ void SymHeapCore::objInvalidate(TObjId obj)
     }
 
     // drop all outgoing has-value edges
-    rootData->liveFields.clear();
+    rootData->liveFields.rw().clear();
     rootData->arena.clear();
 }
 
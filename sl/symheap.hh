@@ -394,6 +394,9 @@ class SymHeapCore {
         /// the last assigned ID of a heap entity (not necessarily still valid)
         unsigned lastId() const;
 
+        /// count of heap entities that are still valid (IDs in use)
+        unsigned cntValidIds() const;
+
     public:
         /**
          * collect all objects having the given value inside
@@ -25,6 +25,7 @@
 #include <cl/clutil.hh>
 
 #include "glconf.hh"
+#include "perfstats.hh"
 #include "prototype.hh"
 #include "shape.hh"
 #include "symcmp.hh"
@@ -135,6 +136,7 @@ struct SymJoinCtx {
     EJoinStatus                 status;
     bool                        forceThreeWay;
     bool                        allowThreeWay;
+    const bool                  widen;
 
     std::set<TObjId /* dst */>  protos;
 
@@ -158,7 +160,7 @@ struct SymJoinCtx {
 
     /// constructor used by joinSymHeaps()
     SymJoinCtx(SymHeap &dst_, SymHeap &sh1_, SymHeap &sh2_,
-            const bool allowThreeWay_):
+            const bool allowThreeWay_, const bool widen_):
         dst(dst_),
         sh1(sh1_),
         sh2(sh2_),
@@ -166,7 +168,8 @@ struct SymJoinCtx {
         l2Drift(0),
         status(JS_USE_ANY),
         forceThreeWay(false),
-        allowThreeWay((1 < GlConf::data.allowThreeWayJoin) && allowThreeWay_)
+        allowThreeWay((1 < GlConf::data.allowThreeWayJoin) && allowThreeWay_),
+        widen(widen_)
     {
         initValMaps();
     }
@@ -180,7 +183,8 @@ struct SymJoinCtx {
         l2Drift(l2Drift_),
         status(JS_USE_ANY),
         forceThreeWay(false),
-        allowThreeWay(0 < GlConf::data.allowThreeWayJoin)
+        allowThreeWay(0 < GlConf::data.allowThreeWayJoin),
+        widen(false)
     {
         initValMaps();
     }
@@ -585,7 +589,7 @@ bool joinCustomValues(
     // compute the resulting range that covers both
     IR::Range rng = join(rng1, rng2);
 
-    if (GlConf::data.intArithmeticLimit
+    if (!ctx.widen && GlConf::data.intArithmeticLimit
             // avoid integer overflow on std::abs(IR::IntMin)
             && (IR::IntMin != rng.lo) && (IR::IntMax != rng.hi))
     {
@@ -1317,7 +1321,7 @@ bool joinMinLength(
     *pDst = std::min(len1, len2);
 
 #if SE_PRESERVE_DLS_MINLEN
-    if (len1 != len2 && OK_DLS == kind && !ctx.joiningData()) {
+    if (len1 != len2 && OK_DLS == kind && !ctx.joiningData() && !ctx.widen) {
         const TMinLen maxLen = std::max(len1, len2);
         if (maxLen < (SE_PRESERVE_DLS_MINLEN))
             return false;
@@ -2555,9 +2559,11 @@ bool joinSymHeaps(
         SymHeap                 *pDst,
         SymHeap                  sh1,
         SymHeap                  sh2,
-        const bool               allowThreeWay)
+        const bool               allowThreeWay,
+        const bool               widen)
 {
     SJ_DEBUG("--> joinSymHeaps()");
+    perfCount(PC_JOIN_SYMHEAPS);
     TStorRef stor = sh1.stor();
     CL_BREAK_IF(&stor != &sh2.stor());
 
@@ -2570,7 +2576,7 @@ bool joinSymHeaps(
     *pDst = SymHeap(stor, new Trace::TransientNode("joinSymHeaps()"));
 
     // initialize symbolic join ctx
-    SymJoinCtx ctx(*pDst, sh1, sh2, allowThreeWay);
+    SymJoinCtx ctx(*pDst, sh1, sh2, allowThreeWay, widen);
     ctx.dst.setExitPoint(sh1/* == sh2 */.exitPoint());
 
     CL_BREAK_IF(!protoCheckConsistency(ctx.sh1));
@@ -42,13 +42,18 @@ bool joinData(
         EJoinStatus             *pStatus         = 0,
         Trace::TIdMapper        *pIdMapper       = 0);
 
-/// @todo some dox
+/**
+ * @todo some dox
+ * @param widen if true, join integral values into ranges and DLSs of different
+ * minimal lengths regardless of int_arithmetic_limit and SE_PRESERVE_DLS_MINLEN
+ */
 bool joinSymHeaps(
         EJoinStatus             *pStatus,
         SymHeap                 *dst,
         SymHeap                  sh1,
         SymHeap                  sh2,
-        bool                     allowThreeWay = true);
+        bool                     allowThreeWay = true,
+        bool                     widen         = false);
 
 /// enable/disable debugging of symjoin
 void debugSymJoin(bool enable);
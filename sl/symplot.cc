@@ -25,6 +25,7 @@
 #include <cl/storage.hh>
 
 #include "plotenum.hh"
+#include "plotsink.hh"
 #include "symheap.hh"
 #include "sympred.hh"
 #include "symseg.hh"
@@ -32,7 +33,6 @@
 #include "worklist.hh"
 
 #include <cctype>
-#include <fstream>
 #include <iomanip>
 #include <map>
 #include <set>
@@ -1289,19 +1289,21 @@ bool plotHeapCore(
 {
     PlotEnumerator *pe = PlotEnumerator::instance();
     std::string plotName(pe->decorate(name));
-    std::string fileName(plotName + ".dot");
 
     if (pName)
         // propagate the resulting name back to the caller
         *pName = plotName;
 
-    // create a dot file
-    std::fstream out(fileName.c_str(), std::ios::out);
-    if (!out) {
+    // create a dot file (or a record in the plot archive)
+    PlotStream str(plotName);
+    const std::string &fileName = str.dest();
+    if (!str.ok()) {
         CL_ERROR("unable to create file '" << fileName << "'");
         return false;
     }
 
+    std::ostream &out = str.out();
+
     // open graph
     out << "digraph " << SL_QUOTE(plotName)
         << " {\n\tlabel=<<FONT POINT-SIZE=\"18\">" << plotName
@@ -1310,7 +1312,6 @@ bool plotHeapCore(
     // check whether we can write to stream
     if (!out.flush()) {
         CL_ERROR("unable to write file '" << fileName << "'");
-        out.close();
         return false;
     }
 
@@ -1327,9 +1328,7 @@ bool plotHeapCore(
 
     // close graph
     out << "}\n";
-    const bool ok = !!out;
-    out.close();
-    return ok;
+    return str.commit();
 }
 
 // /////////////////////////////////////////////////////////////////////////////
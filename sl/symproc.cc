@@ -26,11 +26,13 @@
 #include <cl/memdebug.hh>
 #include <cl/storage.hh>
 
+#include "budget.hh"
 #include "glconf.hh"
 #include "prototype.hh"
 #include "symabstract.hh"
 #include "symbin.hh"
 #include "symbt.hh"
+#include "symexec.hh"
 #include "symgc.hh"
 #include "symheap.hh"
 #include "symplot.hh"
@@ -40,6 +42,7 @@
 #include "symtrace.hh"
 #include "util.hh"
 
+#include <sstream>
 #include <stack>
 #include <stdexcept>
 #include <vector>
@@ -85,6 +88,17 @@ void SymProc::printBackTrace(EMsgLevel level, bool forcePtrace)
         // do not panic for now
         return;
 
+    AnalysisBudget::errorReported();
+
+    if (!GlConf::data.decisionLog.empty() && GlConf::data.replayPath.empty()) {
+        // let the path to the error be re-executed by replay_path
+        static int cntDecisionLogs;
+        std::ostringstream fileName;
+        fileName << GlConf::data.decisionLog << "." << ++cntDecisionLogs;
+        if (writeDecisionLog(fileName.str(), trMsg))
+            CL_NOTE("decision log written to '" << fileName.str() << "'");
+    }
+
 #if SE_PLOT_ERROR_STATES
     plotHeap(sh_, "error-state", lw_);
 #endif
@@ -3009,9 +3023,12 @@ bool SymExecCore::execCore(
     // kill variables
     this->killInsn(insn);
 
-    Trace::Node *trOrig = sh_.traceNode();
-    Trace::Node *trInsn = new Trace::InsnNode(trOrig, &insn, /* bin */ false);
-    sh_.traceUpdate(trInsn);
+    if (Trace::isRecorded(Trace::TL_FULL)) {
+        Trace::Node *trOrig = sh_.traceNode();
+        Trace::Node *trInsn = new Trace::InsnNode(trOrig, &insn, /* bin */ false);
+        sh_.traceUpdate(trInsn);
+    }
+
     dst.insert(sh_);
     return true;
 }
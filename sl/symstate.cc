@@ -24,6 +24,7 @@
 #include <cl/storage.hh>
 
 #include "glconf.hh"
+#include "perfstats.hh"
 #include "symcmp.hh"
 #include "symjoin.hh"
 #include "symplot.hh"
@@ -47,9 +48,10 @@ static int cntLookups = -1;
 
 namespace {
     void debugPlot(const char *name, int idx, const SymHeap &sh) {
-#if DEBUG_SYMJOIN
+#if CL_DEBUG_MSGS
+#   if DEBUG_SYMJOIN
         if (!STREQ(name, "join"))
-#endif
+#   endif
         if (!::debugSymState)
             return;
 
@@ -59,6 +61,11 @@ namespace {
             << FIXW(4) << idx;
 
         plotHeap(sh, str.str().c_str());
+#else
+        (void) name;
+        (void) idx;
+        (void) sh;
+#endif
     }
 }
 
@@ -106,7 +113,10 @@ void SymState::insertNew(const SymHeap &sh)
     heaps_.push_back(dup);
 }
 
-bool SymState::insert(const SymHeap &sh, bool /* allowThreeWay */ )
+bool SymState::insert(
+        const SymHeap                   &sh,
+        bool                            /* allowThreeWay */,
+        bool                            /* widen */)
 {
     if (-1 != this->lookup(sh))
         return false;
@@ -174,14 +184,15 @@ int SymHeapUnion::lookup(const SymHeap &lookFor) const
         return -1;
 
     ++::cntLookups;
-    debugPlot("lookup", 0, lookFor);
+    if (CL_DEBUG_MSGS && ::debugSymState) {
+        // plot all heaps we are going to compare with (checked once per lookup)
+        debugPlot("lookup", 0, lookFor);
+        for (int idx = 0; idx < cnt; ++idx)
+            debugPlot("lookup", /* nth */ idx + 1, this->operator[](idx));
+    }
 
     for(int idx = 0; idx < cnt; ++idx) {
-        const int nth = idx + 1;
-
         const SymHeap &sh = this->operator[](idx);
-        debugPlot("lookup", nth, sh);
-
         if (areEqual(lookFor, sh)) {
             CL_DEBUG("<I> sh #" << idx << " is equal to the given one, "
                     << cnt << " heaps in total");
@@ -201,7 +212,10 @@ int SymHeapUnion::lookup(const SymHeap &lookFor) const
 
 // /////////////////////////////////////////////////////////////////////////////
 // SymStateWithJoin implementation
-void SymStateWithJoin::packState(unsigned idxNew, bool allowThreeWay)
+void SymStateWithJoin::packState(
+        unsigned                        idxNew,
+        bool                            allowThreeWay,
+        bool                            widen)
 {
     for (unsigned idxOld = 0U; idxOld < this->size();) {
         if (idxNew == idxOld) {
@@ -218,7 +232,9 @@ void SymStateWithJoin::packState(unsigned idxNew, bool allowThreeWay)
 
         EJoinStatus     status;
         SymHeap         result(stor, new Trace::TransientNode("packState()"));
-        if (!joinSymHeaps(&status, &result, shOld, shNew, allowThreeWay)) {
+        if (!joinSymHeaps(&status, &result, shOld, shNew, allowThreeWay,
+                    widen))
+        {
             ++idxOld;
             continue;
         }
@@ -276,11 +292,14 @@ bool joinRequested(const bool allowThreeWay)
     return allowThreeWay;
 }
 
-bool SymStateWithJoin::insert(const SymHeap &shNew, bool allowThreeWay)
+bool SymStateWithJoin::insert(
+        const SymHeap                   &shNew,
+        bool                            allowThreeWay,
+        bool                            widen)
 {
     if (!joinRequested(allowThreeWay))
         // we are asked not to check for entailment, only isomorphism
-        return SymHeapUnion::insert(shNew, allowThreeWay);
+        return SymHeapUnion::insert(shNew, allowThreeWay, widen);
 
     const int cnt = this->size();
     if (!cnt) {
@@ -297,7 +316,8 @@ bool SymStateWithJoin::insert(const SymHeap &shNew, bool allowThreeWay)
     ++::cntLookups;
     for(idx = 0; idx < cnt; ++idx) {
         const SymHeap &shOld = this->operator[](idx);
-        if (!joinSymHeaps(&status, &result, shOld, shNew, allowThreeWay))
+        if (!joinSymHeaps(&status, &result, shOld, shNew, allowThreeWay,
+                    widen))
             continue;
 
         if (GlConf::data.forbidHeapReplace && (JS_USE_SH2 == status))
@@ -341,7 +361,7 @@ bool SymStateWithJoin::insert(const SymHeap &shNew, bool allowThreeWay)
             }
 
             this->swapExisting(idx, result);
-            this->packState(idx, allowThreeWay);
+            this->packState(idx, allowThreeWay, widen);
             return true;
 
         case JS_THREE_WAY:
@@ -354,7 +374,7 @@ bool SymStateWithJoin::insert(const SymHeap &shNew, bool allowThreeWay)
             debugPlot("join", 2, result);
 
             this->swapExisting(idx, result);
-            this->packState(idx, allowThreeWay);
+            this->packState(idx, allowThreeWay, widen);
             return true;
     }
 
@@ -599,26 +619,45 @@ SymStateMarked& SymStateMap::operator[](const CodeStorage::Block *bb)
     return d->cont[bb].state;
 }
 
+/// true if heaps can be inserted into dst without looking for them there
+bool bypassLookup(const CodeStorage::Block *dst)
+{
+    if (GlConf::data.joinOnLoopEdgesOnly < 3 || 1U != dst->inbound().size())
+        return false;
+
+    if (cl_is_term_insn(dst->front()->code)
+            || (CL_INSN_COND == dst->back()->code && 2 == dst->size()))
+        // trivial basic block
+        return true;
+
+#if SE_EXTENDED_BASIC_BLOCKS
+    // duplicates are going to be caught at the next merge point or loop entry
+    return dst->isEbbInterior();
+#else
+    return false;
+#endif
+}
+
 bool SymStateMap::insert(
         const CodeStorage::Block        *dst,
         const SymHeap                   &sh,
-        const bool                      allowThreeWay)
+        const bool                      allowThreeWay,
+        const bool                      widen)
 {
+    perfCount(PC_STATE_INSERTS);
+
     // look for the _target_ block
     Private::BlockState &ref = d->cont[dst];
     const unsigned size = ref.state.size();
 
     // insert the given symbolic heap
     bool changed = true;
-    if ((2 < GlConf::data.joinOnLoopEdgesOnly)
-        && (1 == dst->inbound().size() && (cl_is_term_insn(dst->front()->code)
-                || (CL_INSN_COND == dst->back()->code && 2 == dst->size()))))
-    {
+    if (bypassLookup(dst)) {
         CL_DEBUG("SymStateMap::insert() bypasses even the isomorphism check");
         ref.state.insertNew(sh);
     }
     else
-        changed = ref.state.insert(sh, allowThreeWay);
+        changed = ref.state.insert(sh, allowThreeWay, widen);
 
     if (ref.state.size() <= size)
         // if the size did not grow, there must have been at least join
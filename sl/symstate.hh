@@ -62,8 +62,9 @@ class SymState {
          */
         virtual int lookup(const SymHeap &heap) const = 0;
 
-        /// insert given SymHeap object into the state
-        virtual bool insert(const SymHeap &sh, bool allowThreeWay = true);
+        /// insert given SymHeap object into the state, see SymStateMap::insert()
+        virtual bool insert(const SymHeap &sh, bool allowThreeWay = true,
+                bool widen = false);
 
         /// return count of object stored in the container
         size_t size()          const { return heaps_.size();  }
@@ -148,10 +149,11 @@ class SymHeapUnion: public SymState {
 
 class SymStateWithJoin: public SymHeapUnion {
     public:
-        virtual bool insert(const SymHeap &sh, bool allowThreeWay = true);
+        virtual bool insert(const SymHeap &sh, bool allowThreeWay = true,
+                bool widen = false);
 
     private:
-        void packState(unsigned idx, bool allowThreeWay);
+        void packState(unsigned idx, bool allowThreeWay, bool widen);
 };
 
 /**
@@ -273,10 +275,12 @@ class SymStateMap: public IPendingCountProvider {
          * @param dst @b destination basic block (where the insertion occurs)
          * @param sh an instance of symbolic heap that should be inserted
          * @param allowThreeWay if true, three-way join is allowed
+         * @param widen if true, widen when joining (see joinSymHeaps())
          */
         bool insert(const CodeStorage::Block       *dst,
                     const SymHeap                  &sh,
-                    bool                            allowThreeWay = true);
+                    bool                            allowThreeWay = true,
+                    bool                            widen         = false);
 
         /// true if the specified block has ever joined/entailed any given state
         bool anyReuseHappened(const CodeStorage::Block *) const;
@@ -23,12 +23,14 @@
 #include <cl/cldebug.hh>
 #include <cl/storage.hh>
 
+#include "glconf.hh"
+#include "mempool.hh"
 #include "plotenum.hh"
+#include "plotsink.hh"
 #include "symstate.hh"
 #include "worklist.hh"
 
 #include <algorithm>
-#include <fstream>
 #include <map>
 #include <set>
 #include <sstream>
@@ -43,10 +45,23 @@ typedef std::set<TNode>                                 TNodeSet;
 // /////////////////////////////////////////////////////////////////////////////
 // implementation of Trace::NodeBase
 
+/// millions of trace nodes may be created and destroyed during the analysis
+static MemPool nodePool;
+
 NodeBase::~NodeBase()
 {
 }
 
+void* NodeBase::operator new(size_t size)
+{
+    return nodePool.alloc(size);
+}
+
+void NodeBase::operator delete(void *ptr, size_t size)
+{
+    nodePool.release(ptr, size);
+}
+
 Node* NodeBase::parent() const
 {
     CL_BREAK_IF(1 != parents_.size());
@@ -207,6 +222,18 @@ void NodeHandle::reset(Node *node)
 }
 
 
+// /////////////////////////////////////////////////////////////////////////////
+// implementation of Trace::isRecorded()
+
+bool isRecorded(const ETraceLevel level)
+{
+    if (GlConf::data.fixedPoint)
+        // the fixed-point is reconstructed from the complete trace graph
+        return true;
+
+    return (level <= GlConf::data.traceLevel);
+}
+
 // /////////////////////////////////////////////////////////////////////////////
 // implementation of Trace::resolveIdMapping()
 
@@ -446,6 +473,12 @@ void CloneNode::plotNode(TracePlotter &tplot) const
         ", fontcolor=black, label=\"clone\"];\n";
 }
 
+void CompactIdsNode::plotNode(TracePlotter &tplot) const
+{
+    tplot.out << "\t" << SL_QUOTE(this) << " [shape=doubleoctagon, color=gray"
+        ", fontcolor=gray, label=\"compact IDs\"];\n";
+}
+
 void CallEntryNode::plotNode(TracePlotter &tplot) const
 {
     tplot.out << "\t" << SL_QUOTE(this)
@@ -582,19 +615,21 @@ bool plotTrace(const std::string &name, TWorkList &wl, std::string *pName = 0)
 {
     PlotEnumerator *pe = PlotEnumerator::instance();
     std::string plotName(pe->decorate(name));
-    std::string fileName(plotName + ".dot");
 
     if (pName)
         // propagate the resulting name back to the caller
         *pName = plotName;
 
-    // create a dot file
-    std::fstream out(fileName.c_str(), std::ios::out);
-    if (!out) {
+    // create a dot file (or a record in the plot archive)
+    PlotStream str(plotName);
+    const std::string &fileName = str.dest();
+    if (!str.ok()) {
         CL_ERROR("unable to create file '" << fileName << "'");
         return false;
     }
 
+    std::ostream &out = str.out();
+
     // open graph
     out << "digraph " << SL_QUOTE(plotName)
         << " {\n\tlabel=<<FONT POINT-SIZE=\"18\">" << plotName
@@ -603,7 +638,6 @@ bool plotTrace(const std::string &name, TWorkList &wl, std::string *pName = 0)
     // check whether we can write to stream
     if (!out.flush()) {
         CL_ERROR("unable to write file '" << fileName << "'");
-        out.close();
         return false;
     }
 
@@ -613,9 +647,9 @@ bool plotTrace(const std::string &name, TWorkList &wl, std::string *pName = 0)
 
     // close graph
     out << "}\n";
-    out.close();
+    const bool ok = str.commit();
     CL_NOTE("trace graph dumped to '" << fileName << "'");
-    return !!out;
+    return ok;
 }
 
 bool plotTrace(Node *endPoint, const std::string &name, std::string *pName)
@@ -661,6 +695,11 @@ Node* JoinNode::parent() const
 }
 
 Node* /* selected predecessor */ JoinNode::printNode() const
+{
+    return this->pathParent();
+}
+
+Node* JoinNode::pathParent() const
 {
     // FIXME: deal better with join nodes
     return this->parents().front();
@@ -679,6 +718,11 @@ Node* /* selected predecessor */ CallEntryNode::printNode() const
 }
 
 Node* /* selected predecessor */ CallCacheHitNode::printNode() const
+{
+    return this->pathParent();
+}
+
+Node* CallCacheHitNode::pathParent() const
 {
     // follow the result, not the entry!
     return this->parents().at(/* result */ 1);
@@ -691,6 +735,11 @@ Node* /* selected predecessor */ CallFrameNode::printNode() const
 }
 
 Node* /* selected predecessor */ CallDoneNode::printNode() const
+{
+    return this->pathParent();
+}
+
+Node* CallDoneNode::pathParent() const
 {
     // follow the call, not the frame!
     return this->parents().front();
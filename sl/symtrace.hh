@@ -82,6 +82,12 @@ class NodeBase {
         /// force virtual destructor
         virtual ~NodeBase();
 
+        /// trace nodes are allocated from a pool (not meant to be thread-safe)
+        static void* operator new(size_t size);
+
+        /// the size is that of the dynamic type thanks to the virtual destructor
+        static void operator delete(void *ptr, size_t size);
+
         /// this can be called only on nodes with exactly one parent
         virtual Node* parent() const;
 
@@ -148,6 +154,11 @@ class Node: public NodeBase {
 
         /// print the node in a human-readable format if considered interesting
         virtual Node* /* selected predecessor */ printNode() const {
+            return this->pathParent();
+        }
+
+        /// the predecessor that printTrace() follows (0 at the root)
+        virtual Node* pathParent() const {
             return this->parent();
         }
 
@@ -245,8 +256,13 @@ class RootNode: public Node {
         {
         }
 
+        /// the function whose call the trace graph starts with
+        TFnc rootFnc() const { return rootFnc_; }
+
         virtual Node* printNode() const;
 
+        virtual Node* pathParent() const { return 0; }
+
     protected:
         void virtual plotNode(TracePlotter &) const;
 };
@@ -303,6 +319,12 @@ class CondNode: public Node {
             this->idMapper().setNotFoundAction(TIdMapper::NFA_RETURN_IDENTITY);
         }
 
+        /// the conditional jump instruction being traversed
+        TInsn inCnd() const { return inCnd_; }
+
+        /// true if the 'then' branch was taken, false for 'else'
+        bool branch() const { return branch_; }
+
         virtual Node* printNode() const;
 
     protected:
@@ -395,6 +417,8 @@ class JoinNode: public Node {
 
         virtual Node* printNode() const;
 
+        virtual Node* pathParent() const;
+
     protected:
         void virtual plotNode(TracePlotter &) const;
 
@@ -416,6 +440,20 @@ class CloneNode: public Node {
         void virtual plotNode(TracePlotter &) const;
 };
 
+/// trace graph node representing renumbering of heap entities by compactHeapIds()
+class CompactIdsNode: public Node {
+    public:
+        CompactIdsNode(Node *ref):
+            Node(ref)
+        {
+            // the objects not mapped explicitly do not exist any more
+            this->idMapper().setNotFoundAction(TIdMapper::NFA_RETURN_NOTHING);
+        }
+
+    protected:
+        void virtual plotNode(TracePlotter &) const;
+};
+
 /// trace graph node representing a call entry point
 class CallEntryNode: public Node {
     private:
@@ -457,6 +495,8 @@ class CallCacheHitNode: public Node {
 
         virtual Node* printNode() const;
 
+        virtual Node* pathParent() const;
+
     protected:
         void virtual plotNode(TracePlotter &) const;
 };
@@ -512,6 +552,8 @@ class CallDoneNode: public Node {
 
         virtual Node* printNode() const;
 
+        virtual Node* pathParent() const;
+
     protected:
         void virtual plotNode(TracePlotter &) const;
 };
@@ -586,6 +628,16 @@ class UserNode: public Node {
         void virtual plotNode(TracePlotter &) const;
 };
 
+/// levels of trace graph recording, see config.h::SE_TRACE_LEVEL
+enum ETraceLevel {
+    TL_OFF      = 0,        ///< nodes the analysis itself depends on
+    TL_REDUCED  = 1,        ///< also branching on conditions (reduced trace)
+    TL_FULL     = 2         ///< also each executed instruction
+};
+
+/// return true if the nodes of the given level are to be recorded
+bool isRecorded(ETraceLevel);
+
 /// resolve composite ID mapping from trSrc to trDst
 void resolveIdMapping(TIdMapper *pDst, const Node *trSrc, const Node *trDst);
 
@@ -34,7 +34,9 @@
 #include "symheap.hh"
 #include "util.hh"
 
+#include <algorithm>
 #include <set>
+#include <vector>
 
 inline TValId boolToVal(const bool b)
 {
@@ -304,23 +306,28 @@ bool /* complete */ traverseLiveFieldsGeneric(
 {
     // collect all live objects from everywhere
     typedef std::pair<TOffset, TObjType> TItem;
-    std::set<TItem> all;
+    std::vector<TItem> all;
     for (unsigned i = 0; i < N; ++i) {
         SymHeap &sh = *heaps[i];
         const TObjId obj = objs[i];
         if (OBJ_INVALID == obj)
             continue;
 
-        FldList fields;
-        sh.gatherLiveFields(fields, obj);
-        for (const FldHandle &fld : fields) {
+        // the handles must not outlive the gathering (they keep fields alive)
+        FldList live;
+        sh.gatherLiveFields(live, obj);
+        all.reserve(all.size() + live.size());
+        for (const FldHandle &fld : live) {
             const TOffset off = fld.offset();
             const TObjType clt = fld.type();
-            const TItem item(off, clt);
-            all.insert(item);
+            all.push_back(TItem(off, clt));
         }
     }
 
+    // sort by offset and drop duplicates (same order as std::set would give)
+    std::sort(all.begin(), all.end());
+    all.erase(std::unique(all.begin(), all.end()), all.end());
+
     // go through all live objects
     for (const TItem &item : all) {
         const TOffset  off = item.first;
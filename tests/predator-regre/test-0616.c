@@ -0,0 +1,21 @@
+#include <stdlib.h>
+
+int main()
+{
+    int *p = malloc(sizeof *p);
+    if (!p)
+        return EXIT_FAILURE;
+
+    // three heaps that differ in the value of *p
+    if (__VERIFIER_nondet_int())
+        *p = 1;
+    else if (__VERIFIER_nondet_int())
+        *p = 2;
+    else
+        *p = 3;
+
+    // the same double free is reached once per heap
+    free(p);
+    free(p);
+    return EXIT_SUCCESS;
+}